@@ -0,0 +1,445 @@
+#ifndef _FDL_ASYNC_INCLUDE_
+#define _FDL_ASYNC_INCLUDE_
+
+#include <FDL/FDL.hpp>
+
+#ifndef FDL_HAS_COROUTINES
+#	error "FDL/Async.hpp requires C++20 coroutines"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace FDL {
+
+////////////////////////////////////////////////////////
+///	\brief	Runs the blocking work behind the asynchronous operations
+///
+///	Implement post to run operations elsewhere, such as on an event loop
+///	or an io_uring ring, then pass the Executor to the async functions or
+///	make it the default with setDefaultExecutor.
+///
+////////////////////////////////////////////////////////
+class FDLAPI Executor
+{
+public:
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default destructor
+	///
+	////////////////////////////////////////////////////////
+	virtual ~Executor();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Runs task at some later point, possibly on another thread
+	///
+	///	\param	task	The task to run, must be run exactly once
+	///
+	////////////////////////////////////////////////////////
+	virtual void post(std::function<void()> task) = 0;
+};
+
+////////////////////////////////////////////////////////
+///	\brief	An Executor running tasks on a fixed set of threads
+///
+////////////////////////////////////////////////////////
+class FDLAPI ThreadPoolExecutor : public Executor
+{
+private:
+
+	void* mp_pool;
+public:
+
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for a ThreadPoolExecutor
+	///
+	///	\param	threadCount	The threads to start, 0 uses the hardware
+	///		concurrency
+	///
+	////////////////////////////////////////////////////////
+	explicit ThreadPoolExecutor(Uint32 threadCount=0);
+
+	ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+	ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default destructor, runs every posted task then joins the
+	///		threads
+	///
+	////////////////////////////////////////////////////////
+	~ThreadPoolExecutor();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Queues task on the threads
+	///
+	////////////////////////////////////////////////////////
+	void post(std::function<void()> task);
+};
+
+////////////////////////////////////////////////////////
+///	\brief	Retrieves the Executor used when none is given, a
+///		ThreadPoolExecutor unless replaced
+///
+////////////////////////////////////////////////////////
+FDLAPI Executor& getDefaultExecutor();
+
+////////////////////////////////////////////////////////
+///	\brief	Replaces the Executor used when none is given
+///
+///	\param	p_executor	The new default, NULL restores the ThreadPoolExecutor,
+///		must outlive every operation using it
+///
+////////////////////////////////////////////////////////
+FDLAPI void setDefaultExecutor(Executor* p_executor);
+
+////////////////////////////////////////////////////////
+//	Resumes handle through p_executor, or right away when it is NULL
+inline void _resumeCoroutine(Executor* p_executor, std::coroutine_handle<> handle)
+{
+	if(p_executor == NULL) handle.resume();
+	else p_executor->post([handle] { handle.resume(); });
+}
+
+////////////////////////////////////////////////////////
+///	\brief	An awaitable that runs a blocking operation on an Executor
+///
+///	The awaiting coroutine resumes on the thread that ran the operation,
+///	unless resumeOn names the Executor to hand it back to, such as the
+///	event loop it was awaited from.
+///
+///	\note	Exceptions of the operation are rethrown from co_await
+///
+////////////////////////////////////////////////////////
+template<typename T>
+class AsyncOperation
+{
+private:
+
+	Executor* mp_executor;
+	Executor* mp_resumeExecutor;
+	std::function<T()> m_operation;
+	std::optional<T> m_result;
+	std::exception_ptr m_error;
+public:
+
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for an AsyncOperation
+	///
+	///	\param	executor	The Executor to run operation on
+	///	\param	operation	The blocking operation
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation(Executor& executor, std::function<T()> operation)
+		: mp_executor(&executor), mp_resumeExecutor(NULL), m_operation(std::move(operation)) {}
+
+	////////////////////////////////////////////////////////
+	///	\brief	Resumes the awaiting coroutine through executor instead of
+	///		on the thread that ran the operation
+	///
+	///	Usage: FileStream stream = co_await file.asyncOpen().resumeOn(loop);
+	///
+	///	\param	executor	The Executor to resume on, must outlive the
+	///		operation
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation resumeOn(Executor& executor) &&
+	{
+		mp_resumeExecutor = &executor;
+		return std::move(*this);
+	}
+
+	bool await_ready() const noexcept { return false; }
+
+	void await_suspend(std::coroutine_handle<> handle)
+	{
+		mp_executor->post([this, handle]
+		{
+			try
+			{
+				m_result.emplace(m_operation());
+			}
+			catch(...)
+			{
+				m_error = std::current_exception();
+			}
+			_resumeCoroutine(mp_resumeExecutor, handle);
+		});
+	}
+
+	T await_resume()
+	{
+		if(m_error) std::rethrow_exception(m_error);
+		return std::move(*m_result);
+	}
+};
+
+////////////////////////////////////////////////////////
+///	\brief	An AsyncOperation without a result
+///
+////////////////////////////////////////////////////////
+template<>
+class AsyncOperation<void>
+{
+private:
+
+	Executor* mp_executor;
+	Executor* mp_resumeExecutor;
+	std::function<void()> m_operation;
+	std::exception_ptr m_error;
+public:
+
+	AsyncOperation(Executor& executor, std::function<void()> operation)
+		: mp_executor(&executor), mp_resumeExecutor(NULL), m_operation(std::move(operation)) {}
+
+	////////////////////////////////////////////////////////
+	///	\brief	Resumes the awaiting coroutine through executor instead of
+	///		on the thread that ran the operation
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation resumeOn(Executor& executor) &&
+	{
+		mp_resumeExecutor = &executor;
+		return std::move(*this);
+	}
+
+	bool await_ready() const noexcept { return false; }
+
+	void await_suspend(std::coroutine_handle<> handle)
+	{
+		mp_executor->post([this, handle]
+		{
+			try
+			{
+				m_operation();
+			}
+			catch(...)
+			{
+				m_error = std::current_exception();
+			}
+			_resumeCoroutine(mp_resumeExecutor, handle);
+		});
+	}
+
+	void await_resume()
+	{
+		if(m_error) std::rethrow_exception(m_error);
+	}
+};
+
+////////////////////////////////////////////////////////
+///	\brief	A coroutine producing values with co_yield that may co_await
+///		between them
+///
+///	Nothing runs until the first next(), each next() runs to the following
+///	co_yield. The consumer resumes on whichever thread reached the co_yield,
+///	unless resumeOn names the Executor to hand it back to. Destroying the
+///	AsyncGenerator while a next() is pending is undefined.
+///
+////////////////////////////////////////////////////////
+template<typename T>
+class AsyncGenerator
+{
+public:
+
+	struct promise_type;
+private:
+
+	typedef std::coroutine_handle<promise_type> Handle;
+
+	//	Hands control back to whoever awaited next()
+	struct _YieldAwaiter
+	{
+		bool await_ready() const noexcept { return false; }
+
+		std::coroutine_handle<> await_suspend(Handle handle) noexcept
+		{
+			promise_type& promise = handle.promise();
+			if(promise.mp_resumeExecutor == NULL) return promise.m_consumer;
+			_resumeCoroutine(promise.mp_resumeExecutor, promise.m_consumer);
+			return std::noop_coroutine();
+		}
+
+		void await_resume() noexcept {}
+	};
+
+	//	Runs the generator to its next co_yield
+	struct _NextAwaiter
+	{
+		Handle m_handle;
+
+		bool await_ready() const noexcept { return !m_handle || m_handle.done(); }
+
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept
+		{
+			m_handle.promise().m_consumer = consumer;
+			m_handle.promise().m_current.reset();
+			return m_handle;
+		}
+
+		T* await_resume()
+		{
+			if(!m_handle) return NULL;
+			promise_type& promise = m_handle.promise();
+			if(promise.m_error) std::rethrow_exception(std::exchange(promise.m_error, nullptr));
+			return promise.m_current ? &*promise.m_current : NULL;
+		}
+	};
+
+	Handle m_handle;
+
+	explicit AsyncGenerator(Handle handle) : m_handle(handle) {}
+public:
+
+	struct promise_type
+	{
+		std::optional<T> m_current;
+		std::exception_ptr m_error;
+		std::coroutine_handle<> m_consumer;
+		Executor* mp_resumeExecutor = NULL;
+
+		AsyncGenerator get_return_object() { return AsyncGenerator(Handle::from_promise(*this)); }
+
+		std::suspend_always initial_suspend() noexcept { return std::suspend_always(); }
+
+		_YieldAwaiter final_suspend() noexcept { return _YieldAwaiter(); }
+
+		_YieldAwaiter yield_value(T value)
+		{
+			m_current.emplace(std::move(value));
+			return _YieldAwaiter();
+		}
+
+		void return_void() {}
+
+		void unhandled_exception() { m_error = std::current_exception(); }
+	};
+
+	AsyncGenerator(const AsyncGenerator&) = delete;
+	AsyncGenerator& operator=(const AsyncGenerator&) = delete;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Move Constructor for AsyncGenerator
+	///
+	////////////////////////////////////////////////////////
+	AsyncGenerator(AsyncGenerator&& generator) : m_handle(std::exchange(generator.m_handle, Handle())) {}
+
+	////////////////////////////////////////////////////////
+	///	\brief	Move assignment operator for AsyncGenerator
+	///
+	////////////////////////////////////////////////////////
+	AsyncGenerator& operator=(AsyncGenerator&& generator)
+	{
+		if(this == &generator) return *this;
+		if(m_handle) m_handle.destroy();
+		m_handle = std::exchange(generator.m_handle, Handle());
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default destructor, destroys the coroutine
+	///
+	////////////////////////////////////////////////////////
+	~AsyncGenerator()
+	{
+		if(m_handle) m_handle.destroy();
+	}
+
+	////////////////////////////////////////////////////////
+	///	\brief	Awaits the next value
+	///
+	///	\return	An awaitable giving a pointer to the value, valid until the
+	///		following next(), or NULL once the generator is finished
+	////////////////////////////////////////////////////////
+	_NextAwaiter next() { return _NextAwaiter{ m_handle }; }
+
+	////////////////////////////////////////////////////////
+	///	\brief	Resumes the consumer of next() through executor instead of
+	///		on the thread that reached the co_yield
+	///
+	///	\param	executor	The Executor to resume on, must outlive the
+	///		AsyncGenerator
+	///
+	///	\return	The AsyncGenerator
+	////////////////////////////////////////////////////////
+	AsyncGenerator& resumeOn(Executor& executor)
+	{
+		if(m_handle) m_handle.promise().mp_resumeExecutor = &executor;
+		return *this;
+	}
+};
+
+///////////////////////////////////////
+//	File Definitions
+///////////////////////////////////////
+
+inline AsyncOperation<FileStream> File::asyncOpen(Executor& executor)
+{
+	return AsyncOperation<FileStream>(executor, [this] { return open(); });
+}
+
+inline AsyncOperation<FileStream> File::asyncOpen()
+{
+	return asyncOpen(getDefaultExecutor());
+}
+
+inline AsyncOperation<FileStatus> File::asyncStat(Executor& executor)
+{
+	return AsyncOperation<FileStatus>(executor, [this] { return getStatus(); });
+}
+
+inline AsyncOperation<FileStatus> File::asyncStat()
+{
+	return asyncStat(getDefaultExecutor());
+}
+
+inline AsyncOperation<bool> File::asyncCreate(Executor& executor, bool recursive)
+{
+	return AsyncOperation<bool>(executor, [this, recursive] { return create(recursive); });
+}
+
+inline AsyncOperation<bool> File::asyncCreate(bool recursive)
+{
+	return asyncCreate(getDefaultExecutor(), recursive);
+}
+
+inline AsyncOperation<bool> File::asyncRemove(Executor& executor)
+{
+	return AsyncOperation<bool>(executor, [this] { return remove(); });
+}
+
+inline AsyncOperation<bool> File::asyncRemove()
+{
+	return asyncRemove(getDefaultExecutor());
+}
+
+///////////////////////////////////////
+//	FileStream Definitions
+///////////////////////////////////////
+
+inline AsyncOperation<Int64> FileStream::asyncRead(Executor& executor, char* buffer, Int64 size)
+{
+	return AsyncOperation<Int64>(executor, [this, buffer, size] { return read(buffer, size); });
+}
+
+inline AsyncOperation<Int64> FileStream::asyncRead(char* buffer, Int64 size)
+{
+	return asyncRead(getDefaultExecutor(), buffer, size);
+}
+
+inline AsyncOperation<void> FileStream::asyncWrite(Executor& executor, Bytes data, Int64 size)
+{
+	return AsyncOperation<void>(executor, [this, data, size] { write(data, size); });
+}
+
+inline AsyncOperation<void> FileStream::asyncWrite(Bytes data, Int64 size)
+{
+	return asyncWrite(getDefaultExecutor(), data, size);
+}
+
+} /* namespace FDL */
+
+#endif /* _FDL_ASYNC_INCLUDE_ */
@@ -1,10 +1,16 @@
 #ifndef _FDL_INCLUDE_
 #define _FDL_INCLUDE_
 
+#include <cstddef>
 #include <cstring>
 #include <iterator>
 #include <fstream>
 #include <exception>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
 
 /* Snippet from GLFW */
 #if !defined(_WIN32) && (defined(__WIN32__) || defined(WIN32) || defined(__MINGW32__))
@@ -37,12 +43,16 @@
 #define FDL_TRUE	1
 #define FDL_FALSE	0
 
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#	define FDL_HAS_COROUTINES
+#endif
+
 #define FDL_EXCEPTION_CREATE_EXTEND(EXCEPT_NAME, EXTEND_NAME) \
 class FDLAPI EXCEPT_NAME : public EXTEND_NAME \
 { \
 public: \
 EXCEPT_NAME(FDL::String message="") : EXTEND_NAME(message) {} \
-~EXCEPT_NAME() { ~EXTEND_NAME(); } \
+~EXCEPT_NAME() {} \
 } \
 
 #define FDL_EXCEPTION_CREATE(EXCEPT_NAME) FDL_EXCEPTION_CREATE_EXTEND(EXCEPT_NAME, FDL::Exception)
@@ -51,12 +61,26 @@ namespace FDL {
 
 class Exception;
 class String;
+class Arena;
 class File;
 class Directory;
 class FileStream;
 class StreamHandler;
 template<typename T>
 class ImmutableList;
+template<std::size_t N>
+class PathLiteral;
+struct FileStatus;
+struct DiskUsage;
+struct DiskUsageOptions;
+struct CopyOptions;
+struct DiffEntry;
+struct DiffOptions;
+class Executor;
+template<typename T>
+class AsyncOperation;
+template<typename T>
+class AsyncGenerator;
 
 typedef const char* Bytes;
 
@@ -121,65 +145,62 @@ bool FDLAPI createFileNS(String path, bool recursive=true);
 bool FDLAPI deleteFileNS(String path);
 
 ////////////////////////////////////////////////////////
-///	\brief	Converts a string to an appropriate string
-///
-///	Shall replace all instances of escaped '\' with '/'
+///	\brief	Enables the shared cache of open file handles
 ///
-///	\note	Returns NULL if path can not be converted
+///	While enabled, FileStream::open reuses the handle of a path opened
+///	before instead of opening it again. Handles are opened for reading and
+///	writing, or for reading alone if writing is refused, and keep that
+///	mode until invalidateHandleCache drops them. Least recently used
+///	handles are closed once more than
+///	handleBudget are cached in total, a handle still used by a FileStream
+///	closes when that FileStream closes. File::remove and
+///	File::move drop the handles of the paths they change.
 ///
-///	\param	originalStr	The original string to convert
+///	\param	handleBudget	The most handles kept open by the cache
 ///
+///	\return	Whether the platform supports the cache
 ////////////////////////////////////////////////////////
-String FDLAPI convertString(String originalStr);
+bool FDLAPI enableHandleCache(Uint32 handleBudget=1024);
 
 ////////////////////////////////////////////////////////
-///	\brief	A base exception class for FDL
+///	\brief	Disables the shared handle cache and closes the cached handles
+///		no FileStream is using
 ///
 ////////////////////////////////////////////////////////
-class FDLAPI Exception : public std::exception
-{
-protected:
-
-	String m_message;
-public:
-
-	////////////////////////////////////////////////////////
-	///	\brief	Constructor for an Exception
-	///
-	///	\param	message	The message to assign
-	///
-	////////////////////////////////////////////////////////
-	virtual Exception(String message="");
-
-	////////////////////////////////////////////////////////
-	///	\brief	The Default Destructor
-	///
-	////////////////////////////////////////////////////////
-	virtual ~Exception();
-
-	////////////////////////////////////////////////////////
-	///	\brief	return the message
-	///
-	////////////////////////////////////////////////////////
-	String what();
+void FDLAPI disableHandleCache();
 
-	////////////////////////////////////////////////////////
-	///	\brief	Casts the exception to return the message into a new string
-	///
-	////////////////////////////////////////////////////////
-	String operator String();
+////////////////////////////////////////////////////////
+///	\brief	Drops the cached handle of a path, for changes made outside FDL
+///
+///	\param	path	The native path whose handle is dropped
+///
+////////////////////////////////////////////////////////
+void FDLAPI invalidateHandleCache(String path);
 
-	////////////////////////////////////////////////////////
-	///	\brief	Assigns a message
-	///
-	///	\param	message	The message to assign
-	///
-	////////////////////////////////////////////////////////
-	Exception& operator=(String message);
-};
+////////////////////////////////////////////////////////
+///	\brief	Forgets every directory resolved by File::canonical
+///
+///	File::remove and File::move do this when they change a directory.
+///	Cached directories are also checked against the file system before
+///	use, so directories renamed and links retargeted outside FDL are
+///	resolved again without it.
+///
+////////////////////////////////////////////////////////
+void FDLAPI invalidateCanonicalCache();
 
-FDL_EXCEPTION_CREATE(UnsupportedException);
-FDL_EXCEPTION_CREATE(BadPathException);
+////////////////////////////////////////////////////////
+///	\brief	Converts a string to an appropriate string
+///
+///	Normalizes the path the way File and PathLiteral do: all instances of
+///	escaped '\' are replaced with '/', repeated slashes and "." components
+///	are removed.
+///
+///	\note	Returns String::null_str if path can not be converted
+///
+///	\param	originalStr	The original string to convert
+///
+////////////////////////////////////////////////////////
+String FDLAPI convertString(String originalStr);
 
 ////////////////////////////////////////////////////////
 ///	\brief	A small and simple class for handling character strings
@@ -191,10 +212,11 @@ private:
 
 	std::size_t m_size;
 	const char* m_str;
+	bool m_owner;
 public:
 
 	///	\brief	A consistent null string
-	static const String null_str = String(NULL);
+	static const String null_str;
 
 	////////////////////////////////////////////////////////
 	///	\brief	Constructor for a String
@@ -202,7 +224,7 @@ public:
 	///	\param	strings	The string to set
 	///
 	////////////////////////////////////////////////////////
-	String(char* string = "");
+	String(char* string);
 
 	////////////////////////////////////////////////////////
 	///	\brief	Constructor for a String
@@ -219,7 +241,7 @@ public:
 	///	\param	strings	The string to set
 	///
 	////////////////////////////////////////////////////////
-	String(const char* string);
+	String(const char* string="");
 
 	////////////////////////////////////////////////////////
 	///	\brief	Constructor for a String
@@ -238,6 +260,15 @@ public:
 	////////////////////////////////////////////////////////
 	String(const String& string);
 
+	////////////////////////////////////////////////////////
+	///	\brief	Move Constructor for a String, takes ownership of the
+	///		character buffer of string
+	///
+	///	\param	strings	The string to move, becomes a null string
+	///
+	////////////////////////////////////////////////////////
+	String(String&& string) noexcept;
+
 	////////////////////////////////////////////////////////
 	///	\brief	Destructor for a String
 	///
@@ -260,6 +291,22 @@ public:
 	////////////////////////////////////////////////////////
 	String& operator=(const char* string);
 
+	////////////////////////////////////////////////////////
+	///	\brief	Copy assignment operator for a String
+	///
+	///	\param	string	The String to copy
+	///
+	////////////////////////////////////////////////////////
+	String& operator=(const String& string);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Move assignment operator for a String
+	///
+	///	\param	string	The String to move, becomes a null string
+	///
+	////////////////////////////////////////////////////////
+	String& operator=(String&& string) noexcept;
+
 	////////////////////////////////////////////////////////
 	///	\brief	A cast operator for character strings
 	///
@@ -305,232 +352,1014 @@ public:
 	///
 	////////////////////////////////////////////////////////
 	bool isNullStr() const;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Creates a String that refers to string instead of copying it
+	///
+	///	\warn	string must outlive the returned String, copies of the
+	///		returned String hold their own buffer
+	///
+	///	\param	string	The characters to refer to
+	///	\param	size	The number of characters in string
+	///
+	////////////////////////////////////////////////////////
+	static String borrow(const char* string, std::size_t size);
 };
 
 ////////////////////////////////////////////////////////
-///	\brief	The simpliest file managing object
+///	\brief	A base exception class for FDL
 ///
 ////////////////////////////////////////////////////////
-class FDLAPI File
+class FDLAPI Exception : public std::exception
 {
 protected:
 
-	Str m_fullPath;
+	String m_message;
 public:
 
-	FDL_EXCEPTION_CREATE(FileFailException);
-	FDL_EXCEPTION_CREATE_EXTEND(FileMissingException, FileFailException);
-	FDL_EXCEPTION_CREATE_EXTEND(FileSizeFailureException, FileFailException);
-
-	////////////////////////////////////////////////////////
-	///	\brief	Constructor for a File
-	///
-	///	\param	path	The path File points to, relative or absoulte
-	///
-	///	\throws	BadPathException	If path is invalid
-	///
-	////////////////////////////////////////////////////////
-	File(String path);
-
 	////////////////////////////////////////////////////////
-	///	\brief	Constructor for a File
-	///
-	///	\param	root	The root to start in
-	///	\param	path	The path File points to according to root
+	///	\brief	Constructor for an Exception
 	///
-	///	\throws	BadPathException	If path is invalid or could not be formatted
+	///	\param	message	The message to assign
 	///
 	////////////////////////////////////////////////////////
-	File(String root, String path);
+	Exception(String message="");
 
 	////////////////////////////////////////////////////////
-	///	\brief	Constructor for a File
-	///
-	///	\param	root	The root to start in
-	///	\param	path	The path File points to according to root
-	///
-	///	\throws	BadPathException	If path is invalid or could not be formatted
+	///	\brief	The Default Destructor
 	///
 	////////////////////////////////////////////////////////
-	File(File root, String path="");
+	virtual ~Exception();
 
 	////////////////////////////////////////////////////////
-	///	\brief	Default destructor
+	///	\brief	return the message
 	///
 	////////////////////////////////////////////////////////
-	~File();
+	String what();
 
 	////////////////////////////////////////////////////////
-	///	\brief	Retrieves the full path of the file
+	///	\brief	Casts the exception to return the message into a new string
 	///
 	////////////////////////////////////////////////////////
-	String getFullPath() const;
+	operator String() const;
 
 	////////////////////////////////////////////////////////
-	///	\brief	Retrieves the extension of the file
-	///
-	///	\note	return NULL if isDirectory is true
+	///	\brief	Assigns a message
 	///
-	////////////////////////////////////////////////////////
-	String getExtension() const;
-
-	////////////////////////////////////////////////////////
-	///	\brief Retrieves the root path of the file
+	///	\param	message	The message to assign
 	///
 	////////////////////////////////////////////////////////
-	String getRootPath() const;
+	Exception& operator=(String message);
+};
 
-	////////////////////////////////////////////////////////
-	///	\brief	Retrieves the file name
-	///
-	////////////////////////////////////////////////////////
-	String getFileName() const;
+FDL_EXCEPTION_CREATE(UnsupportedException);
+FDL_EXCEPTION_CREATE(BadPathException);
 
-	////////////////////////////////////////////////////////
-	///	\brief	Retrieves the file name and extension
-	///
-	////////////////////////////////////////////////////////
-	String getFullName() const;
+////////////////////////////////////////////////////////
+///	\brief	A bump allocator releasing everything it handed out at once
+///
+///	Memory is carved out of large chunks and only returned by release or
+///	destruction, which makes it cheap for the many small Strings and Files
+///	of one bulk operation. Nothing allocated from an Arena may outlive it.
+///
+///	\note	An Arena is not thread safe
+///
+////////////////////////////////////////////////////////
+class FDLAPI Arena
+{
+private:
 
-	////////////////////////////////////////////////////////
-	///	\brief	Retrieves the byte size of the File
-	///
-	///	\throws	File::FileSizeFailException	If size retevial can't be done
-	///	\throws	File::FileMissingException	If file does not exist
-	///
-	////////////////////////////////////////////////////////
-	UInt64 getSize();
+	void* mp_chunks;
+	char* mp_next;
+	std::size_t m_remaining;
+	std::size_t m_chunkSize;
+	std::size_t m_used;
+public:
 
 	////////////////////////////////////////////////////////
-	///	\brief	Whether the file exists
+	///	\brief	Constructor for an Arena, no memory is taken until the first
+	///		allocation
 	///
-	////////////////////////////////////////////////////////
-	bool doesExist();
-
-	////////////////////////////////////////////////////////
-	///	\brief	Whether the file is a directory
+	///	\param	chunkSize	The bytes taken from the system at a time
 	///
 	////////////////////////////////////////////////////////
-	virtual bool isDirectory();
+	explicit Arena(std::size_t chunkSize=64 * 1024);
 
-	////////////////////////////////////////////////////////
-	///	\brief	Whether the file is a binary file, according to extension
-	///
-	///	\note	Does not actually check File for binary designation
-	///
-	////////////////////////////////////////////////////////
-	virtual bool isBinary();
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
 
 	////////////////////////////////////////////////////////
-	///	\brief	Creates the file according to the path
-	///
-	///	\param	recursive	Whether recursive creation is done
-	///
-	///	\throws	File::FileFailException	If File can not be created
-	///	\throws	File::FileMissingException	If recursive is false and path does
-	///		not exist
+	///	\brief	Default destructor, releases every allocation
 	///
-	///	\return	Whether the file creation succeeded
 	////////////////////////////////////////////////////////
-	bool create(bool recursive=true);
+	~Arena();
 
 	////////////////////////////////////////////////////////
-	///	\brief	Deletes the file according to the path
-	///
-	///	\throws	File::FileMissingException	If file couldn't be found
+	///	\brief	Allocates uninitialized memory
 	///
-	///	\return	Whether the file deletion succeeded
-	////////////////////////////////////////////////////////
-	bool delete();
-
-	////////////////////////////////////////////////////////
-	///	\brief	Moves the file according to newPath
+	///	\param	size	The bytes to allocate
+	///	\param	alignment	The alignment of the memory, a power of two
 	///
-	///	\throws	File::FileFailException	If newFile can't be created
-	///	\throws File::FileMissingException	If recursiveCreate is false and newFile's
-	///		root path does not exist
+	///	\throws	std::bad_alloc	If a chunk can not be allocated
 	///
-	///	\return	Whether the file move succeeded
+	///	\return	The memory, valid until release
 	////////////////////////////////////////////////////////
-	bool move(File newFile, bool recursiveCreate=true);
+	void* allocate(std::size_t size, std::size_t alignment=alignof(std::max_align_t));
 
 	////////////////////////////////////////////////////////
-	///	\brief	Opens the File in a stream, auto-determines binary treatment
-	///
-	///	\see FDL::File::open(bool binaryOpen)	Manually determines binary treatment
+	///	\brief	Copies characters into the Arena
 	///
-	///	\throws	File::FileFailException	If FileStream can't be opened
-	///	\throws File::FileMissingException	If File does not exist
+	///	\param	string	The characters to copy
+	///	\param	size	The number of characters in string
 	///
-	///	\return	A FileStream pointing to the File's stream
+	///	\return	A String borrowing the copy, copies of it hold their own buffer
 	////////////////////////////////////////////////////////
-	FileStream open();
+	String copyString(const char* string, std::size_t size);
 
 	////////////////////////////////////////////////////////
-	///	\brief	Opens the File in a stream
-	///
-	///	\param	binaryOpen	Determines whether the file is treated as a binary
-	///
-	///	\throws	File::FileFailException	If FileStream can't be opened
-	///	\throws File::FileMissingException	If File does not exist
+	///	\brief	Frees every allocation at once, destructors are not run
 	///
-	///	\return	A FileStream pointing to the File's stream
 	////////////////////////////////////////////////////////
-	FileStream open(bool binaryOpen);
+	void release();
 
 	////////////////////////////////////////////////////////
-	///	\brief	Converts the File to an appropriate OS native path
+	///	\brief	Retrieves the bytes handed out since the last release
 	///
-	///	\return	On Unix, return m_fullPath. On Windows, return Windows compliant
-	///		version of m_fullPath
 	////////////////////////////////////////////////////////
-	String toNativePath() const;
+	std::size_t getUsed() const;
 };
 
-class Directory : public File
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+#	define FDL_HAS_PATH_LITERAL
+#	define _FDL_PATH_CONSTEXPR constexpr
+#else
+#	define _FDL_PATH_CONSTEXPR inline
+#endif
+
+//	Normalizes the size characters of path into p_normalized, which holds
+//	at least size + 1, by the one rule PathLiteral follows while compiling
+//	and File at run time. Backslashes become slashes, repeated slashes and
+//	"." components are removed, except the leading pair of a UNC path.
+//	Returns NULL, or why path is invalid: empty, ending in a slash, holding
+//	a NUL or, on Windows, a character names can not hold
+_FDL_PATH_CONSTEXPR const char* _normalizePath(const char* path, std::size_t size, char* p_normalized,
+	std::size_t& normalizedSize)
 {
+	std::size_t length = 0;
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		char character = path[i] == '\\' ? '/' : path[i];
+		if(character == '\0') return "Path holds a NUL character";
+#ifdef _WIN32
+		if(static_cast<unsigned char>(character) < 0x20 || character == '<' || character == '>'
+			|| character == '"' || character == '|' || character == '?' || character == '*')
+			return "Path holds an invalid character";
+		if(character == ':' && (length != 1 || !((p_normalized[0] >= 'a' && p_normalized[0] <= 'z')
+			|| (p_normalized[0] >= 'A' && p_normalized[0] <= 'Z'))))
+			return "Path holds ':' outside of a drive";
+#endif
+		if(character == '/')
+		{
+			//	Only the first character starts an absolute path, and only
+			//	the second may repeat it, for a UNC path
+			if(length == 0 && i > 0) continue;
+			if(length == 1 && p_normalized[0] == '/' && i > 1) continue;
+			if(length > 1 && p_normalized[length - 1] == '/') continue;
+			if(length == 1 && p_normalized[0] == '.')
+			{
+				length = 0;
+				continue;
+			}
+			if(length >= 2 && p_normalized[length - 1] == '.' && p_normalized[length - 2] == '/')
+			{
+				--length;
+				continue;
+			}
+		}
+		p_normalized[length++] = character;
+	}
+	if(length >= 2 && p_normalized[length - 1] == '.' && p_normalized[length - 2] == '/') length -= 2;
+	if(length == 0 || p_normalized[length - 1] == '/') return "Path is empty or a directory";
+	p_normalized[length] = '\0';
+	normalizedSize = length;
+	return NULL;
+}
+
+#ifdef FDL_HAS_PATH_LITERAL
+////////////////////////////////////////////////////////
+///	\brief	A path normalized and verified while compiling
+///
+///	The path follows the same rule as a path given to File at run time:
+///	backslashes become slashes, repeated slashes and "." components are
+///	removed, except the leading pair of a UNC path. The offsets of the
+///	file name and extension are found for File to keep.
+///	A path that is empty, ends in a slash, or holds a character the
+///	platform does not allow in names fails to compile when constructed in
+///	a constant expression. On Windows these are control characters and
+///	<>"|?*, and ':' outside of a drive letter.
+///
+///	\see	FDL_PATH	For a path literal before C++20
+///	\see	FDL::literals::operator""_path	For a path literal in C++20
+///
+////////////////////////////////////////////////////////
+template<std::size_t N>
+class PathLiteral
+{
+private:
+
+	char m_path[N];
+	std::size_t m_size;
+	std::size_t m_nameOffset;
+	std::size_t m_extensionOffset;
+
 public:
 
 	////////////////////////////////////////////////////////
-	///	\brief	Constructor for a Directory
+	///	\brief	Constructor for a PathLiteral
 	///
-	///	\param	path	The path File points to, relative or absoulte, empty
-	///		points to working directory
+	///	\param	path	The string literal to normalize
+	///
+	///	\throws	BadPathException	If path is invalid, which fails to
+	///		compile in a constant expression
 	///
 	////////////////////////////////////////////////////////
-	Directory(String path="");
+	constexpr PathLiteral(const char (&path)[N])
+		: m_path(), m_size(0), m_nameOffset(0), m_extensionOffset(0)
+	{
+		const char* p_error = _normalizePath(path, N - 1, m_path, m_size);
+		if(p_error != NULL) throw BadPathException(p_error);
+
+		m_nameOffset = m_size;
+		while(m_nameOffset > 0 && m_path[m_nameOffset - 1] != '/') --m_nameOffset;
+		m_extensionOffset = m_size;
+		for(std::size_t i = m_size - 1; i > m_nameOffset; --i)
+		{
+			if(m_path[i] == '.')
+			{
+				m_extensionOffset = i + 1;
+				break;
+			}
+		}
+	}
 
 	////////////////////////////////////////////////////////
-	///	\brief	Constructor for a File
-	///
-	///	\param	root	The root to start in
-	///	\param	path	The path File points to
+	///	\brief	Retrieves the normalized path
 	///
 	////////////////////////////////////////////////////////
-	Directory(String root, String path);
+	constexpr const char* c_str() const { return m_path; }
 
 	////////////////////////////////////////////////////////
-	///	\brief	Constructor for a File
-	///
-	///	\param	root	The root to start in
-	///	\param	path	The path File points to
+	///	\brief	Retrieves the size of the normalized path
 	///
 	////////////////////////////////////////////////////////
-	Directory(File root, String path="");
+	constexpr std::size_t size() const { return m_size; }
 
 	////////////////////////////////////////////////////////
-	///	\brief	Opens a File in the Directory
-	///
-	///	\param	path	A path to search for File
+	///	\brief	Retrieves the offset of the file name within the path
 	///
 	////////////////////////////////////////////////////////
-	File open(String path);
+	constexpr std::size_t getNameOffset() const { return m_nameOffset; }
 
 	////////////////////////////////////////////////////////
-	///	\brief	Retrieves an ImmutableList of the contained files
+	///	\brief	Retrieves the offset of the extension within the path, past
+	///		the '.', equal to size() if there is no extension
 	///
 	////////////////////////////////////////////////////////
-	ImmutableList<File>	getContainedFiles();
+	constexpr std::size_t getExtensionOffset() const { return m_extensionOffset; }
+};
+
+////////////////////////////////////////////////////////
+///	\brief	Creates a static PathLiteral from a string literal, for use
+///		before C++20
+///
+///	Usage: FDL::File file(FDL_PATH("config\\app.json"));
+///
+////////////////////////////////////////////////////////
+#define FDL_PATH(literal) \
+([]() -> const FDL::PathLiteral<sizeof(literal)>& \
+{ \
+static constexpr FDL::PathLiteral<sizeof(literal)> s_path(literal); \
+return s_path; \
+}()) \
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+//	Holds the characters of a literal so they can be a template argument
+template<std::size_t N>
+struct _PathLiteralSource
+{
+	char value[N];
+
+	constexpr _PathLiteralSource(const char (&literal)[N]) : value()
+	{
+		for(std::size_t i = 0; i < N; ++i) value[i] = literal[i];
+	}
+};
+
+//	Gives each distinct path literal a single static PathLiteral
+template<_PathLiteralSource Source>
+struct _PathLiteralStorage
+{
+	static constexpr PathLiteral<sizeof(Source.value)> value = PathLiteral<sizeof(Source.value)>(Source.value);
+};
+
+inline namespace literals {
+
+////////////////////////////////////////////////////////
+///	\brief	Creates a static PathLiteral from a string literal
+///
+///	Usage: FDL::File file("config\\app.json"_path);
+///
+////////////////////////////////////////////////////////
+template<_PathLiteralSource Source>
+constexpr const PathLiteral<sizeof(Source.value)>& operator""_path()
+{
+	return _PathLiteralStorage<Source>::value;
+}
+
+} /* namespace literals */
+#endif
+#endif /* FDL_HAS_PATH_LITERAL */
+
+////////////////////////////////////////////////////////
+///	\brief	The simpliest file managing object
+///
+////////////////////////////////////////////////////////
+class FDLAPI File
+{
+protected:
+
+	String m_fullPath;
+
+	//	Makes a File holding fullPath as is, without converting or
+	//	verifying it, a borrowed fullPath stays borrowed
+	static File _fromFullPath(String fullPath);
+private:
+
+	std::size_t m_nameOffset;
+	std::size_t m_extensionOffset;
+
+	File();
+
+	//	Finds the offsets of the name and extension within m_fullPath
+	void _locateComponents();
+public:
+
+	FDL_EXCEPTION_CREATE(FileFailException);
+	FDL_EXCEPTION_CREATE_EXTEND(FileMissingException, FileFailException);
+	FDL_EXCEPTION_CREATE_EXTEND(FileSizeFailureException, FileFailException);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for a File
+	///
+	///	\param	path	The path File points to, relative or absoulte
+	///
+	///	\throws	BadPathException	If path is invalid
+	///
+	////////////////////////////////////////////////////////
+	File(String path);
+
+#ifdef FDL_HAS_PATH_LITERAL
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for a File from a path checked while compiling,
+	///		does no parsing and no allocation, the offsets of the name and
+	///		extension come from path
+	///
+	///	\warn	path must outlive the File, as those made by FDL_PATH and _path do
+	///
+	///	\param	path	The PathLiteral File points to
+	///
+	////////////////////////////////////////////////////////
+	template<std::size_t N>
+	File(const PathLiteral<N>& path)
+		: m_fullPath(String::borrow(path.c_str(), path.size())), m_nameOffset(path.getNameOffset()),
+		m_extensionOffset(path.getExtensionOffset()) {}
+#endif
+
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for a File
+	///
+	///	\param	root	The root to start in
+	///	\param	path	The path File points to according to root
+	///
+	///	\throws	BadPathException	If path is invalid or could not be formatted
+	///
+	////////////////////////////////////////////////////////
+	File(String root, String path);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for a File
+	///
+	///	\param	root	The root to start in
+	///	\param	path	The path File points to according to root
+	///
+	///	\throws	BadPathException	If path is invalid or could not be formatted
+	///
+	////////////////////////////////////////////////////////
+	File(const File& root, String path);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Copy Constructor for a File
+	///
+	///	\param	file	The File to copy
+	///
+	////////////////////////////////////////////////////////
+	File(const File& file);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Move Constructor for a File, takes the path buffer of file
+	///
+	///	\param	file	The File to move, left with a null path
+	///
+	////////////////////////////////////////////////////////
+	File(File&& file) noexcept;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default destructor
+	///
+	////////////////////////////////////////////////////////
+	virtual ~File();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Copy assignment operator for a File
+	///
+	///	\param	file	The File to copy
+	///
+	////////////////////////////////////////////////////////
+	File& operator=(const File& file);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Move assignment operator for a File
+	///
+	///	\param	file	The File to move, left with a null path
+	///
+	////////////////////////////////////////////////////////
+	File& operator=(File&& file) noexcept;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Retrieves the full path of the file
+	///
+	////////////////////////////////////////////////////////
+	String getFullPath() const;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Retrieves the name of the file, without its directories
+	///
+	////////////////////////////////////////////////////////
+	String getName() const;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Retrieves the extension of the file, past the last '.' of
+	///		its name
+	///
+	///	\note	return an empty String if the name has no extension, a
+	///		leading '.' does not start one
+	///
+	////////////////////////////////////////////////////////
+	String getExtension() const;
+
+	////////////////////////////////////////////////////////
+	///	\brief Retrieves the root path of the file
+	///
+	////////////////////////////////////////////////////////
+	String getRootPath() const;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Retrieves the file name
+	///
+	////////////////////////////////////////////////////////
+	String getFileName() const;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Retrieves the file name and extension
+	///
+	////////////////////////////////////////////////////////
+	String getFullName() const;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Retrieves the byte size of the File
+	///
+	///	\throws	File::FileSizeFailException	If size retevial can't be done
+	///	\throws	File::FileMissingException	If file does not exist
+	///
+	////////////////////////////////////////////////////////
+	Uint64 getSize();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Whether the file exists
+	///
+	////////////////////////////////////////////////////////
+	bool doesExist();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Whether the file is a directory
+	///
+	////////////////////////////////////////////////////////
+	virtual bool isDirectory();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Whether the file is a binary file, according to extension
+	///
+	///	\note	Does not actually check File for binary designation
+	///
+	////////////////////////////////////////////////////////
+	virtual bool isBinary();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Retrieves the existence, type, size and modification time of
+	///		the File in a single query
+	///
+	///	\note	Does not throw if the File does not exist
+	///
+	////////////////////////////////////////////////////////
+	FileStatus getStatus();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Creates the file according to the path
+	///
+	///	\param	recursive	Whether recursive creation is done
+	///
+	///	\throws	File::FileFailException	If File can not be created
+	///	\throws	File::FileMissingException	If recursive is false and path does
+	///		not exist
+	///
+	///	\return	Whether the file creation succeeded
+	////////////////////////////////////////////////////////
+	bool create(bool recursive=true);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Deletes the file according to the path
+	///
+	///	\throws	File::FileMissingException	If file couldn't be found
+	///
+	///	\return	Whether the file deletion succeeded
+	////////////////////////////////////////////////////////
+	bool remove();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Moves the file according to newPath
+	///
+	///	\throws	File::FileFailException	If newFile can't be created
+	///	\throws File::FileMissingException	If recursiveCreate is false and newFile's
+	///		root path does not exist
+	///
+	///	\return	Whether the file move succeeded
+	////////////////////////////////////////////////////////
+	bool move(File newFile, bool recursiveCreate=true);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Opens the File in a stream, auto-determines binary treatment
+	///
+	///	\see FDL::File::open(bool binaryOpen)	Manually determines binary treatment
+	///
+	///	\throws	File::FileFailException	If FileStream can't be opened
+	///	\throws File::FileMissingException	If File does not exist
+	///	\throws FileStream::IsDirectoryException	If File is a directory
+	///
+	///	\return	A FileStream pointing to the File's stream
+	////////////////////////////////////////////////////////
+	FileStream open();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Opens the File in a stream
+	///
+	///	\param	binaryOpen	Determines whether the file is treated as a binary
+	///
+	///	\throws	File::FileFailException	If FileStream can't be opened
+	///	\throws File::FileMissingException	If File does not exist
+	///	\throws FileStream::IsDirectoryException	If File is a directory
+	///
+	///	\return	A FileStream pointing to the File's stream
+	////////////////////////////////////////////////////////
+	FileStream open(bool binaryOpen);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Converts the File to an appropriate OS native path
+	///
+	///	\return	On Unix, return m_fullPath. On Windows, return Windows compliant
+	///		version of m_fullPath
+	////////////////////////////////////////////////////////
+	String toNativePath() const;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Resolves the File into an absolute path free of symbolic
+	///		links, "." and ".."
+	///
+	///	The directories leading to the File are resolved once and cached,
+	///	later calls under the same directories only look at the last
+	///	component. Relative paths are resolved against the working
+	///	directory.
+	///
+	///	\see	FDL::invalidateCanonicalCache()
+	///
+	///	\throws	File::FileMissingException	If the File or a directory above it
+	///		does not exist
+	///
+	///	\return	The canonical File
+	////////////////////////////////////////////////////////
+	File canonical() const;
+
+#ifdef FDL_HAS_COROUTINES
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable open(), run on executor
+	///
+	///	\warn	The File must outlive the co_await
+	///
+	///	\see	FDL::File::open()
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<FileStream> asyncOpen(Executor& executor);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable open(), run on the default Executor
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<FileStream> asyncOpen();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable getStatus(), run on executor
+	///
+	///	\see	FDL::File::getStatus()
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<FileStatus> asyncStat(Executor& executor);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable getStatus(), run on the default Executor
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<FileStatus> asyncStat();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable create(bool recursive), run on executor
+	///
+	///	\see	FDL::File::create(bool recursive)
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<bool> asyncCreate(Executor& executor, bool recursive=true);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable create(bool recursive), run on the default Executor
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<bool> asyncCreate(bool recursive=true);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable remove(), run on executor
+	///
+	///	\see	FDL::File::remove()
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<bool> asyncRemove(Executor& executor);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable remove(), run on the default Executor
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<bool> asyncRemove();
+#endif
+};
+
+class Directory : public File
+{
+private:
+
+	//	Appends a File for every entry, with paths copied into p_arena if
+	//	given
+	void _readContainedFiles(std::vector<File>& files, Arena* p_arena);
+
+#ifdef FDL_HAS_COROUTINES
+	//	Enumerates the contained files on executor, with paths copied into
+	//	p_arena if given
+	AsyncGenerator<File> _asyncEntries(Executor& executor, Arena* p_arena);
+#endif
+public:
+
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for a Directory
+	///
+	///	\param	path	The path File points to, relative or absoulte, empty
+	///		points to working directory
+	///
+	////////////////////////////////////////////////////////
+	Directory(String path="");
+
+#ifdef FDL_HAS_PATH_LITERAL
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for a Directory from a path checked while
+	///		compiling, does no parsing and no allocation
+	///
+	///	\warn	path must outlive the Directory
+	///
+	///	\param	path	The PathLiteral Directory points to
+	///
+	////////////////////////////////////////////////////////
+	template<std::size_t N>
+	Directory(const PathLiteral<N>& path) : File(path) {}
+#endif
+
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for a File
+	///
+	///	\param	root	The root to start in
+	///	\param	path	The path File points to
+	///
+	////////////////////////////////////////////////////////
+	Directory(String root, String path);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for a File
+	///
+	///	\param	root	The root to start in
+	///	\param	path	The path File points to
+	///
+	////////////////////////////////////////////////////////
+	Directory(const File& root, String path="");
+
+	////////////////////////////////////////////////////////
+	///	\brief	Copy Constructor for a Directory
+	///
+	///	\param	directory	The Directory to copy
+	///
+	////////////////////////////////////////////////////////
+	Directory(const Directory& directory);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Move Constructor for a Directory
+	///
+	///	\param	directory	The Directory to move, left with a null path
+	///
+	////////////////////////////////////////////////////////
+	Directory(Directory&& directory) noexcept;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Copy assignment operator for a Directory
+	///
+	///	\param	directory	The Directory to copy
+	///
+	////////////////////////////////////////////////////////
+	Directory& operator=(const Directory& directory);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Move assignment operator for a Directory
+	///
+	///	\param	directory	The Directory to move, left with a null path
+	///
+	////////////////////////////////////////////////////////
+	Directory& operator=(Directory&& directory) noexcept;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Opens a File in the Directory
+	///
+	///	\param	path	A path to search for File
+	///
+	////////////////////////////////////////////////////////
+	File open(String path);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Retrieves an ImmutableList of the contained files
+	///
+	////////////////////////////////////////////////////////
+	ImmutableList<File>	getContainedFiles();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Retrieves an ImmutableList of the contained files, with the
+	///		list and every path allocated from arena
+	///
+	///	\warn	The list and the Files in it must not outlive arena, copies
+	///		of them hold their own memory
+	///
+	///	\param	arena	The Arena to allocate from
+	///
+	///	\throws	File::FileMissingException	If the Directory can not be opened
+	///
+	////////////////////////////////////////////////////////
+	ImmutableList<File>	getContainedFiles(Arena& arena);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Creates a temporary file in the Directory
+	///
+	///	Where supported the file has no name until FileStream::publish,
+	///	otherwise it gets a unique hidden name. Either way it disappears
+	///	when the FileStream closes unpublished, an unnamed file even if the
+	///	process crashes.
+	///
+	///	\throws	File::FileFailException	If the file can not be created
+	///
+	///	\return	An open FileStream on the temporary file
+	////////////////////////////////////////////////////////
+	FileStream createTemp();
+
+#ifdef FDL_HAS_COROUTINES
+	////////////////////////////////////////////////////////
+	///	\brief	Enumerates the contained files as they are read, directory
+	///		reads run on executor in batches
+	///
+	///	Usage: while(File* p_file = co_await entries.next()) { ... }
+	///
+	///	\warn	The Directory must outlive the first next()
+	///
+	///	\throws	File::FileMissingException	From next(), if the Directory can
+	///		not be opened
+	///
+	////////////////////////////////////////////////////////
+	AsyncGenerator<File> asyncEntries(Executor& executor);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Enumerates the contained files on the default Executor
+	///
+	////////////////////////////////////////////////////////
+	AsyncGenerator<File> asyncEntries();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Enumerates the contained files on executor, with the path of
+	///		every File allocated from arena
+	///
+	///	\warn	The Files must not outlive arena, copies of them hold their
+	///		own memory. arena must not be used elsewhere until the
+	///		AsyncGenerator is finished
+	///
+	///	\see	FDL::Directory::asyncEntries(Executor& executor)
+	///
+	////////////////////////////////////////////////////////
+	AsyncGenerator<File> asyncEntries(Executor& executor, Arena& arena);
+#endif
+
+	////////////////////////////////////////////////////////
+	///	\brief	Totals the space used by the Directory and everything below it
+	///
+	///	Subdirectories are scanned concurrently, each opened relative to its
+	///	parent so deep trees are not limited by the path length. Entries
+	///	that can not be read are left out and counted in
+	///	DiskUsage::skippedCount. Symbolic links are counted as links, never
+	///	followed.
+	///
+	///	\param	options	The scanning options
+	///
+	///	\throws	File::FileMissingException	If the Directory can not be opened
+	///	\throws	UnsupportedException	If the platform can not scan directories
+	///
+	///	\return	The totals of the Directory
+	////////////////////////////////////////////////////////
+	DiskUsage diskUsage(const DiskUsageOptions& options);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Totals the space used by the Directory with default options
+	///
+	///	\see	FDL::Directory::diskUsage(const DiskUsageOptions& options)
+	///
+	////////////////////////////////////////////////////////
+	DiskUsage diskUsage();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Totals the space used by the Directory, with the paths and
+	///		subdirectory list of the result allocated from arena
+	///
+	///	\warn	The result must not outlive arena, copies of it hold their
+	///		own memory
+	///
+	///	\see	FDL::Directory::diskUsage(const DiskUsageOptions& options)
+	///
+	////////////////////////////////////////////////////////
+	DiskUsage diskUsage(const DiskUsageOptions& options, Arena& arena);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Copies the Directory and everything below it into destination
+	///
+	///	Every directory is created first, then files are copied concurrently.
+	///	Where the platform allows, file contents are cloned or copied by the
+	///	kernel instead of through user buffers. Symbolic links are recreated,
+	///	other special files are skipped. Links already in destination are
+	///	replaced rather than written through.
+	///
+	///	\param	destination	The Directory to copy into, created if missing
+	///	\param	options	The copying options
+	///
+	///	\throws	BadPathException	If destination is the Directory or lies inside it
+	///	\throws	File::FileMissingException	If the Directory can not be opened
+	///	\throws	File::FileFailException	If any entry could not be copied, the
+	///		other entries are still copied
+	///	\throws	UnsupportedException	If the platform can not copy directories
+	///
+	///	\return	The number of files copied, skipped files are not counted
+	////////////////////////////////////////////////////////
+	Uint64 copyTo(const Directory& destination, const CopyOptions& options);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Copies the Directory into destination with default options
+	///
+	///	\see	FDL::Directory::copyTo(const Directory& destination, const CopyOptions& options)
+	///
+	////////////////////////////////////////////////////////
+	Uint64 copyTo(const Directory& destination);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Reports how other differs from the Directory, as changes
+	///		are found
+	///
+	///	Both trees are compared a directory at a time by merging their
+	///	name-sorted listings, subdirectories present on both sides are
+	///	compared concurrently. A directory present on one side only is
+	///	reported once, without its contents. A file is modified when its
+	///	size differs, or when its modification time (and inode, if asked)
+	///	differs and, if asked, so does its content. A directory removed
+	///	while the trees are compared counts as empty.
+	///
+	///	\param	other	The Directory compared against, the newer side
+	///	\param	options	The comparison options
+	///	\param	callback	Receives each change, calls are never concurrent
+	///
+	///	\throws	File::FileMissingException	If either Directory can not be opened
+	///	\throws	File::FileFailException	If anything within either tree can
+	///		not be read, the scan stops and reports nothing further
+	///	\throws	UnsupportedException	If the platform can not compare directories
+	///
+	////////////////////////////////////////////////////////
+	void diff(const Directory& other, const DiffOptions& options, std::function<void(const DiffEntry&)> callback);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Reports how other differs from the Directory with default
+	///		options
+	///
+	///	\see	FDL::Directory::diff(const Directory& other, const DiffOptions& options, std::function<void(const DiffEntry&)> callback)
+	///
+	////////////////////////////////////////////////////////
+	void diff(const Directory& other, std::function<void(const DiffEntry&)> callback);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Reports how other differs from the Directory, with the path of
+	///		every DiffEntry allocated from arena
+	///
+	///	\warn	The paths must not outlive arena, copies of them hold their
+	///		own memory
+	///
+	///	\see	FDL::Directory::diff(const Directory& other, const DiffOptions& options, std::function<void(const DiffEntry&)> callback)
+	///
+	////////////////////////////////////////////////////////
+	void diff(const Directory& other, const DiffOptions& options, std::function<void(const DiffEntry&)> callback,
+		Arena& arena);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Records the Directory tree into snapshotFile, for a later
+	///		diffSnapshot
+	///
+	///	The snapshot keeps the name, type, size, modification time and inode
+	///	of every entry, never the contents, and is only read back on a
+	///	machine of the same byte order.
+	///
+	///	\param	snapshotFile	The file to write, replaced if it exists
+	///
+	///	\throws	File::FileMissingException	If the Directory can not be opened
+	///	\throws	File::FileFailException	If anything within the tree can not
+	///		be read or the snapshot can not be written
+	///	\throws	UnsupportedException	If the platform can not write snapshots
+	///
+	////////////////////////////////////////////////////////
+	void writeSnapshot(const File& snapshotFile);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Reports how the Directory differs from a snapshot written by
+	///		writeSnapshot, as changes are found
+	///
+	///	The snapshot is the older side and is streamed alongside a depth-first
+	///	walk of the Directory, so only the listings along the current path
+	///	are held. The walk runs on the calling thread, threadCount and
+	///	compareContents are ignored. A directory removed during the walk
+	///	counts as empty.
+	///
+	///	\param	snapshotFile	The snapshot compared against
+	///	\param	options	The comparison options
+	///	\param	callback	Receives each change
+	///
+	///	\throws	File::FileMissingException	If the Directory or snapshotFile
+	///		can not be opened
+	///	\throws	File::FileFailException	If anything within the tree can not
+	///		be read or the snapshot is damaged
+	///	\throws	UnsupportedException	If the platform can not read snapshots
+	///
+	////////////////////////////////////////////////////////
+	void diffSnapshot(const File& snapshotFile, const DiffOptions& options, std::function<void(const DiffEntry&)> callback);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Reports how the Directory differs from a snapshot with
+	///		default options
+	///
+	///	\see	FDL::Directory::diffSnapshot(const File& snapshotFile, const DiffOptions& options, std::function<void(const DiffEntry&)> callback)
+	///
+	////////////////////////////////////////////////////////
+	void diffSnapshot(const File& snapshotFile, std::function<void(const DiffEntry&)> callback);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Reports how the Directory differs from a snapshot, with the
+	///		path of every DiffEntry allocated from arena
+	///
+	///	\warn	The paths must not outlive arena, copies of them hold their
+	///		own memory
+	///
+	///	\see	FDL::Directory::diffSnapshot(const File& snapshotFile, const DiffOptions& options, std::function<void(const DiffEntry&)> callback)
+	///
+	////////////////////////////////////////////////////////
+	void diffSnapshot(const File& snapshotFile, const DiffOptions& options, std::function<void(const DiffEntry&)> callback,
+		Arena& arena);
 };
 
 class FileStream
@@ -538,7 +1367,44 @@ class FileStream
 private:
 
 	File m_file;
-	std::fstream* mp_fileStream;
+	std::fstream m_fileStream;
+	bool m_binary;
+	void* mp_pipeline;
+	std::shared_ptr<void> m_handle;
+	Int64 m_handlePosition;
+	bool m_writeFailed;
+	String m_temporaryPath;
+	bool m_temporary;
+
+	friend class Directory;
+	friend class File;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for an unchecked FileStream, used by File::open
+	///		which only examines the file when opening fails
+	///
+	///	\param	file	The file to open
+	///	\param	handleBinary	Whether file is handled as binary file
+	///	\param	checkDirectory	Whether to throw IsDirectoryException for a
+	///		directory right away
+	///
+	////////////////////////////////////////////////////////
+	FileStream(File file, bool handleBinary, bool checkDirectory);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for a temporary FileStream, used by
+	///		Directory::createTemp
+	///
+	///	\param	directory	The Directory holding the temporary file
+	///	\param	descriptor	The open descriptor of the temporary file
+	///	\param	temporaryPath	The name given to the file, null if unnamed
+	///
+	////////////////////////////////////////////////////////
+	FileStream(const Directory& directory, int descriptor, String temporaryPath);
+
+	Int64 _readDirect(char* buffer, Int64 size);
+	bool _writeDirect(Bytes data, Int64 size);
+	void _seekHandle(Int64 position);
 public:
 
 	FDL_EXCEPTION_CREATE(EOSException); // End Of Stream Exception
@@ -569,14 +1435,49 @@ public:
 	FileStream(File file, bool handleBinary);
 
 	////////////////////////////////////////////////////////
-	///	\brief	Default destructor, closes mp_fileStream
+	///	\brief	FileStream owns its stream and can not be copied
+	///
+	////////////////////////////////////////////////////////
+	FileStream(const FileStream&) = delete;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Move Constructor for FileStream, takes over the File and the
+	///		open stream of stream
+	///
+	///	\param	stream	The FileStream to move, left closed
+	///
+	////////////////////////////////////////////////////////
+	FileStream(FileStream&& stream) noexcept;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default destructor, closes m_fileStream
 	///
 	////////////////////////////////////////////////////////
 	~FileStream();
 
+	////////////////////////////////////////////////////////
+	///	\brief	FileStream owns its stream and can not be copied
+	///
+	////////////////////////////////////////////////////////
+	FileStream& operator=(const FileStream&) = delete;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Move assignment operator for FileStream, closes this stream
+	///		then takes over the File and the open stream of stream
+	///
+	///	\param	stream	The FileStream to move, left closed
+	///
+	////////////////////////////////////////////////////////
+	FileStream& operator=(FileStream&& stream) noexcept;
+
 	////////////////////////////////////////////////////////
 	///	\brief	Opens the FileStream
 	///
+	///	While the handle cache is enabled the FileStream shares the cached
+	///	descriptor of its path and keeps its own position.
+	///
+	///	\see	FDL::enableHandleCache(Uint32 handleBudget)
+	///
 	///	\return	Whether FileStream opened correctly
 	////////////////////////////////////////////////////////
 	bool open();
@@ -611,6 +1512,16 @@ public:
 	////////////////////////////////////////////////////////
 	Int64 read(Bytes data);
 
+	////////////////////////////////////////////////////////
+	///	\brief	Reads up to size bytes from the FileStream
+	///
+	///	\param	buffer	The buffer to read into
+	///	\param	size	The size of buffer
+	///
+	///	\return	The number of bytes read, 0 at the end of the stream
+	////////////////////////////////////////////////////////
+	Int64 read(char* buffer, Int64 size);
+
 	////////////////////////////////////////////////////////
 	///	\brief	Sets the position of the writer
 	///
@@ -627,7 +1538,7 @@ public:
 	///	\throws	File::FileSizeFailException	If writer position can't be retrieved
 	///
 	////////////////////////////////////////////////////////
-	UInt64 tellWrite();
+	Uint64 tellWrite();
 
 	////////////////////////////////////////////////////////
 	///	\brief	Sets the position of the reader
@@ -650,16 +1561,121 @@ public:
 	////////////////////////////////////////////////////////
 	///	\brief	Flushes the FileStream
 	///
+	///	A FileStream on a cached or temporary handle writes straight through,
+	///	so it reports any write that failed since it was opened or last
+	///	seeked.
+	///
 	///	\return	Whether flush succeeded
 	////////////////////////////////////////////////////////
 	bool flush();
 
 	////////////////////////////////////////////////////////
 	///	\brief	Retrieves the std::fstream currently active, returns NULL
-	///		if isOpen is false
+	///		if isOpen is false or the FileStream uses a cached handle
+	///
+	///	\note	Disables pipelining, the stream is not shared with the
+	///		helper thread
 	///
 	////////////////////////////////////////////////////////
 	std::fstream* getStream();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Starts reading ahead, a helper thread fills the next buffers
+	///		while the caller consumes the current one
+	///
+	///	Seeking, writing or moving the FileStream disables pipelining.
+	///
+	///	\param	bufferSize	The byte size of each buffer
+	///	\param	bufferCount	The buffers shared with the helper, at least 2
+	///
+	///	\return	Whether the FileStream is open and pipelining started
+	////////////////////////////////////////////////////////
+	bool enableReadAhead(std::size_t bufferSize=1 << 20, std::size_t bufferCount=2);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Starts writing behind, writes are copied into buffers that a
+	///		helper thread writes out while the caller continues
+	///
+	///	write blocks once bufferCount buffers are queued, flush waits until
+	///	every queued buffer is written. Seeking, reading or moving the
+	///	FileStream disables pipelining.
+	///
+	///	\param	bufferSize	The byte size of each buffer
+	///	\param	bufferCount	The buffers shared with the helper, at least 2
+	///
+	///	\return	Whether the FileStream is open and pipelining started
+	////////////////////////////////////////////////////////
+	bool enableWriteBehind(std::size_t bufferSize=1 << 20, std::size_t bufferCount=2);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Stops pipelining, queued writes are written and unread
+	///		read-ahead is discarded, the position is where the caller left it
+	///
+	///	Never throws, the move operations rely on it.
+	///
+	///	\return	Whether every queued write succeeded
+	////////////////////////////////////////////////////////
+	bool disablePipelining();
+
+	////////////////////////////////////////////////////////
+	///	\brief	Whether reading ahead or writing behind is active
+	///
+	////////////////////////////////////////////////////////
+	bool isPipelined() const;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Gives a FileStream from Directory::createTemp its name
+	///
+	///	The file appears under name all at once, fully written. An existing
+	///	file of that name is never replaced.
+	///
+	///	\param	name	The path to publish under, relative to the Directory
+	///		the temporary file was created in
+	///
+	///	\return	Whether the FileStream was temporary and is now published,
+	///		false without publishing if any write to it failed
+	////////////////////////////////////////////////////////
+	bool publish(String name);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Whether the FileStream is an unpublished temporary file
+	///
+	////////////////////////////////////////////////////////
+	bool isTemporary() const;
+
+#ifdef FDL_HAS_COROUTINES
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable read(char* buffer, Int64 size), run on executor
+	///
+	///	\warn	The FileStream and buffer must not move or be used until
+	///		the co_await finishes
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<Int64> asyncRead(Executor& executor, char* buffer, Int64 size);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable read(char* buffer, Int64 size), run on the default
+	///		Executor
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<Int64> asyncRead(char* buffer, Int64 size);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable write(Bytes data, Int64 size), run on executor
+	///
+	///	\warn	The FileStream and data must not move or be used until
+	///		the co_await finishes
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<void> asyncWrite(Executor& executor, Bytes data, Int64 size=-1);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Awaitable write(Bytes data, Int64 size), run on the default
+	///		Executor
+	///
+	////////////////////////////////////////////////////////
+	AsyncOperation<void> asyncWrite(Bytes data, Int64 size=-1);
+#endif
 };
 
 template<typename T>
@@ -668,7 +1684,11 @@ class FDLAPI ImmutableList
 private:
 
 	const T* mp_valuesList;
-	const std::size_t m_size;
+	std::size_t m_size;
+	Arena* mp_arena;
+
+	//	Destroys the values and frees their storage unless an Arena owns it
+	void _release();
 public:
 
 	typedef std::iterator<std::random_access_iterator_tag, T> Iterator;
@@ -688,13 +1708,50 @@ public:
 	////////////////////////////////////////////////////////
 	ImmutableList(const T* p_values, const size_t size);
 
+	////////////////////////////////////////////////////////
+	///	\brief	Constructor for ImmutableList, moves the values instead of
+	///		copying them
+	///
+	///	\warn	If p_arena is given the list must not outlive it, copies of
+	///		the list hold their own memory
+	///
+	///	\param	p_values	An array of values of type T, left moved from
+	///	\param	size	The size of the stored array
+	///	\param	p_arena	The Arena to allocate the storage from, NULL
+	///		allocates it on its own
+	///
+	////////////////////////////////////////////////////////
+	ImmutableList(T* p_values, const size_t size, Arena* p_arena);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Copy Constructor for ImmutableList
+	///
+	///	\param	list	The ImmutableList to copy
+	///
+	////////////////////////////////////////////////////////
+	ImmutableList(const ImmutableList& list);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Move Constructor for ImmutableList, takes the values of list
+	///
+	///	\param	list	The ImmutableList to move, left empty
+	///
+	////////////////////////////////////////////////////////
+	ImmutableList(ImmutableList&& list) noexcept;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default destructor, releases the held values
+	///
+	////////////////////////////////////////////////////////
+	~ImmutableList();
+
 	////////////////////////////////////////////////////////
 	///	\brief	Constructor for ImmutableList
 	///
 	///	\param	values	An object of HolderT which holds type T
 	///
 	////////////////////////////////////////////////////////
-	template<typename HolderT>
+	template<template<typename> class HolderT>
 	ImmutableList(const HolderT<T> values);
 
 	////////////////////////////////////////////////////////
@@ -703,7 +1760,15 @@ public:
 	///	\param	rhs	A reference to a constant ImmutableList to assign
 	///
 	////////////////////////////////////////////////////////
-	ImmutableList& operator=(const ImmutableList &rhs) const;
+	ImmutableList& operator=(const ImmutableList &rhs);
+
+	////////////////////////////////////////////////////////
+	///	\brief	Move assignment operator for ImmutableList
+	///
+	///	\param	rhs	The ImmutableList to move, left empty
+	///
+	////////////////////////////////////////////////////////
+	ImmutableList& operator=(ImmutableList&& rhs) noexcept;
 
 	////////////////////////////////////////////////////////
 	///	\brief	Retrieves an immutable group of values for the list
@@ -715,7 +1780,7 @@ public:
 	///	\brief	Retrieves  constant size value of the list
 	///
 	////////////////////////////////////////////////////////
-	const size_t getSize() const;
+	size_t getSize() const;
 
 	////////////////////////////////////////////////////////
 	///	\brief	Retrieves the beginning iterator
@@ -730,6 +1795,291 @@ public:
 	const Iterator getEnd() const;
 };
 
+////////////////////////////////////////////////////////
+///	\brief	The state of a File at the time File::getStatus was called
+///
+////////////////////////////////////////////////////////
+struct FDLAPI FileStatus
+{
+	///	\brief	Whether the File exists, the other values are zero if not
+	bool exists;
+
+	///	\brief	Whether the File is a directory
+	bool directory;
+
+	///	\brief	The byte size of the File
+	Uint64 size;
+
+	///	\brief	The last modification, in nanoseconds since the Unix epoch
+	Int64 modifiedTime;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default Constructor, describes a File that does not exist
+	///
+	////////////////////////////////////////////////////////
+	FileStatus();
+};
+
+////////////////////////////////////////////////////////
+///	\brief	Options controlling Directory::diskUsage
+///
+////////////////////////////////////////////////////////
+struct FDLAPI DiskUsageOptions
+{
+	///	\brief	Worker threads used to stat entries, 0 uses the hardware
+	///		concurrency
+	Uint32 threadCount;
+
+	///	\brief	Whether files with several hard links are counted only once,
+	///		identified by device and inode
+	bool deduplicateHardLinks;
+
+	///	\brief	Whether a DiskUsage is reported for each immediate subdirectory
+	bool subdirectoryRollups;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default Constructor, uses every hardware thread, deduplicates
+	///		hard links and does not report subdirectories
+	///
+	////////////////////////////////////////////////////////
+	DiskUsageOptions();
+};
+
+////////////////////////////////////////////////////////
+///	\brief	Options controlling Directory::copyTo
+///
+////////////////////////////////////////////////////////
+struct FDLAPI CopyOptions
+{
+	///	\brief	Files copied at once, 0 uses the hardware concurrency
+	Uint32 threadCount;
+
+	///	\brief	Whether permission bits are copied from the source
+	bool preserveMode;
+
+	///	\brief	Whether access and modification times are copied from the source
+	bool preserveTimes;
+
+	///	\brief	Whether files and links whose destination already has the
+	///		same size and modification time are left alone, only reliable
+	///		when the previous copy also preserved times
+	bool skipUnchanged;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default Constructor, uses every hardware thread, preserves
+	///		mode and times and copies every file
+	///
+	////////////////////////////////////////////////////////
+	CopyOptions();
+};
+
+////////////////////////////////////////////////////////
+///	\brief	Options controlling Directory::diff
+///
+////////////////////////////////////////////////////////
+struct FDLAPI DiffOptions
+{
+	///	\brief	Directories compared at once, 0 uses the hardware concurrency
+	Uint32 threadCount;
+
+	///	\brief	Whether a differing inode counts as a change, only useful
+	///		between trees sharing inodes, such as hard-linked snapshots
+	bool compareInodes;
+
+	///	\brief	Whether files of equal size whose other metadata differs are
+	///		compared by content before being reported as modified
+	bool compareContents;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default Constructor, uses every hardware thread and compares
+	///		size and modification time only
+	///
+	////////////////////////////////////////////////////////
+	DiffOptions();
+};
+
+////////////////////////////////////////////////////////
+///	\brief	A single change found by Directory::diff
+///
+////////////////////////////////////////////////////////
+struct FDLAPI DiffEntry
+{
+	enum Change
+	{
+		ADDED,
+		REMOVED,
+		MODIFIED
+	};
+
+	///	\brief	How the entry changed
+	Change change;
+
+	///	\brief	The path of the entry relative to the compared Directories
+	String path;
+
+	///	\brief	Whether the entry is a directory
+	bool directory;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default Constructor, a modified file without a path
+	///
+	////////////////////////////////////////////////////////
+	DiffEntry();
+};
+
+////////////////////////////////////////////////////////
+///	\brief	The space used by a directory tree
+///
+////////////////////////////////////////////////////////
+struct FDLAPI DiskUsage
+{
+	///	\brief	The full path of the directory the totals belong to
+	String path;
+
+	///	\brief	The sum of the file sizes
+	Uint64 apparentBytes;
+
+	///	\brief	The sum of the space allocated on disk
+	Uint64 allocatedBytes;
+
+	///	\brief	The number of non-directory entries
+	Uint64 fileCount;
+
+	///	\brief	The number of directories, including the directory itself
+	Uint64 directoryCount;
+
+	///	\brief	The number of entries left out of the totals because they
+	///		could not be read, an unreadable directory counts once for
+	///		everything below it
+	Uint64 skippedCount;
+
+	///	\brief	Totals of each immediate subdirectory, empty unless
+	///		DiskUsageOptions::subdirectoryRollups is set
+	ImmutableList<DiskUsage> subdirectories;
+
+	////////////////////////////////////////////////////////
+	///	\brief	Default Constructor, all totals are zero
+	///
+	////////////////////////////////////////////////////////
+	DiskUsage();
+};
+
+///////////////////////////////////////
+//	ImmutableList Definitions
+///////////////////////////////////////
+
+template<typename T>
+ImmutableList<T>::ImmutableList() : mp_valuesList(NULL), m_size(0), mp_arena(NULL) {}
+
+template<typename T>
+ImmutableList<T>::ImmutableList(const T* p_values, const size_t size)
+	: mp_valuesList(NULL), m_size(0), mp_arena(NULL)
+{
+	if(p_values == NULL || size == 0) return;
+	T* p_copy = static_cast<T*>(::operator new(size * sizeof(T)));
+	std::size_t i = 0;
+	try
+	{
+		for(; i < size; ++i) new(p_copy + i) T(p_values[i]);
+	}
+	catch(...)
+	{
+		while(i > 0) p_copy[--i].~T();
+		::operator delete(p_copy);
+		throw;
+	}
+	mp_valuesList = p_copy;
+	m_size = size;
+}
+
+template<typename T>
+ImmutableList<T>::ImmutableList(T* p_values, const size_t size, Arena* p_arena)
+	: mp_valuesList(NULL), m_size(0), mp_arena(p_arena)
+{
+	if(p_values == NULL || size == 0) return;
+	T* p_moved = static_cast<T*>(p_arena != NULL ? p_arena->allocate(size * sizeof(T), alignof(T))
+		: ::operator new(size * sizeof(T)));
+	std::size_t i = 0;
+	try
+	{
+		for(; i < size; ++i) new(p_moved + i) T(std::move(p_values[i]));
+	}
+	catch(...)
+	{
+		while(i > 0) p_moved[--i].~T();
+		if(p_arena == NULL) ::operator delete(p_moved);
+		throw;
+	}
+	mp_valuesList = p_moved;
+	m_size = size;
+}
+
+template<typename T>
+ImmutableList<T>::ImmutableList(const ImmutableList& list)
+	: ImmutableList(list.mp_valuesList, list.m_size) {}
+
+template<typename T>
+ImmutableList<T>::ImmutableList(ImmutableList&& list) noexcept
+	: mp_valuesList(list.mp_valuesList), m_size(list.m_size), mp_arena(list.mp_arena)
+{
+	list.mp_valuesList = NULL;
+	list.m_size = 0;
+	list.mp_arena = NULL;
+}
+
+template<typename T>
+ImmutableList<T>::~ImmutableList()
+{
+	_release();
+}
+
+template<typename T>
+void ImmutableList<T>::_release()
+{
+	for(std::size_t i = m_size; i > 0; --i) mp_valuesList[i - 1].~T();
+	if(mp_arena == NULL) ::operator delete(const_cast<T*>(mp_valuesList));
+	mp_valuesList = NULL;
+	m_size = 0;
+	mp_arena = NULL;
+}
+
+template<typename T>
+ImmutableList<T>& ImmutableList<T>::operator=(const ImmutableList &rhs)
+{
+	if(this != &rhs) *this = ImmutableList(rhs);
+	return *this;
+}
+
+template<typename T>
+ImmutableList<T>& ImmutableList<T>::operator=(ImmutableList&& rhs) noexcept
+{
+	if(this == &rhs) return *this;
+	_release();
+	mp_valuesList = rhs.mp_valuesList;
+	m_size = rhs.m_size;
+	mp_arena = rhs.mp_arena;
+	rhs.mp_valuesList = NULL;
+	rhs.m_size = 0;
+	rhs.mp_arena = NULL;
+	return *this;
+}
+
+template<typename T>
+const T* ImmutableList<T>::getValues() const
+{
+	return mp_valuesList;
+}
+
+template<typename T>
+size_t ImmutableList<T>::getSize() const
+{
+	return m_size;
+}
+
 } /* namespace FDL */
 
+#ifdef FDL_HAS_COROUTINES
+#	include <FDL/Async.hpp>
+#endif
+
 #endif /* _FDL_INCLUDE_ */
@@ -0,0 +1,104 @@
+#include <FDL/FDL.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+
+using namespace FDL;
+
+//	Sits in front of every chunk, the chunks form a list newest first
+struct _ArenaChunk
+{
+	_ArenaChunk* p_next;
+};
+
+static const std::size_t CHUNK_HEADER_SIZE =
+	(sizeof(_ArenaChunk) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+static std::size_t _getPadding(const char* p_position, std::size_t alignment)
+{
+	return (alignment - reinterpret_cast<std::uintptr_t>(p_position) % alignment) % alignment;
+}
+
+static _ArenaChunk* _allocateChunk(std::size_t size)
+{
+	_ArenaChunk* p_chunk = static_cast<_ArenaChunk*>(std::malloc(CHUNK_HEADER_SIZE + size));
+	if(p_chunk == NULL) throw std::bad_alloc();
+	p_chunk->p_next = NULL;
+	return p_chunk;
+}
+
+Arena::Arena(std::size_t chunkSize)
+	: mp_chunks(NULL), mp_next(NULL), m_remaining(0), m_chunkSize(chunkSize < 1024 ? 1024 : chunkSize), m_used(0)
+{}
+
+Arena::~Arena()
+{
+	release();
+}
+
+void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+	if(size == 0) size = 1;
+	std::size_t padding = _getPadding(mp_next, alignment);
+	if(mp_next == NULL || padding + size > m_remaining)
+	{
+		//	A large block gets a chunk of its own behind the current one, so
+		//	the space left in the current chunk is still used
+		if(size + alignment > m_chunkSize / 4)
+		{
+			_ArenaChunk* p_chunk = _allocateChunk(size + alignment);
+			_ArenaChunk* p_current = static_cast<_ArenaChunk*>(mp_chunks);
+			if(p_current != NULL)
+			{
+				p_chunk->p_next = p_current->p_next;
+				p_current->p_next = p_chunk;
+			}
+			else mp_chunks = p_chunk;
+			char* p_data = reinterpret_cast<char*>(p_chunk) + CHUNK_HEADER_SIZE;
+			m_used += size;
+			return p_data + _getPadding(p_data, alignment);
+		}
+
+		_ArenaChunk* p_chunk = _allocateChunk(m_chunkSize);
+		p_chunk->p_next = static_cast<_ArenaChunk*>(mp_chunks);
+		mp_chunks = p_chunk;
+		mp_next = reinterpret_cast<char*>(p_chunk) + CHUNK_HEADER_SIZE;
+		m_remaining = m_chunkSize;
+		padding = _getPadding(mp_next, alignment);
+	}
+
+	char* p_block = mp_next + padding;
+	mp_next = p_block + size;
+	m_remaining -= padding + size;
+	m_used += size;
+	return p_block;
+}
+
+String Arena::copyString(const char* string, std::size_t size)
+{
+	if(string == NULL) return String(static_cast<const char*>(NULL));
+	char* p_copy = static_cast<char*>(allocate(size + 1, 1));
+	std::memcpy(p_copy, string, size);
+	p_copy[size] = '\0';
+	return String::borrow(p_copy, size);
+}
+
+void Arena::release()
+{
+	_ArenaChunk* p_chunk = static_cast<_ArenaChunk*>(mp_chunks);
+	while(p_chunk != NULL)
+	{
+		_ArenaChunk* p_next = p_chunk->p_next;
+		std::free(p_chunk);
+		p_chunk = p_next;
+	}
+	mp_chunks = NULL;
+	mp_next = NULL;
+	m_remaining = 0;
+	m_used = 0;
+}
+
+std::size_t Arena::getUsed() const
+{
+	return m_used;
+}
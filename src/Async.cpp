@@ -0,0 +1,135 @@
+#include "Platform.hpp"
+#include "TaskPool.hpp"
+
+#ifdef FDL_HAS_COROUTINES
+
+#include <atomic>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace FDL;
+
+static std::atomic<Executor*> s_defaultExecutor(NULL);
+
+Executor::~Executor()
+{}
+
+ThreadPoolExecutor::ThreadPoolExecutor(Uint32 threadCount) : mp_pool(new _TaskPool(threadCount))
+{}
+
+ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+	_TaskPool* p_pool = static_cast<_TaskPool*>(mp_pool);
+	try
+	{
+		p_pool->wait();
+	}
+	catch(...)
+	{}
+	delete p_pool;
+}
+
+void ThreadPoolExecutor::post(std::function<void()> task)
+{
+	static_cast<_TaskPool*>(mp_pool)->submit(std::move(task));
+}
+
+Executor& FDL::getDefaultExecutor()
+{
+	Executor* p_executor = s_defaultExecutor.load();
+	if(p_executor != NULL) return *p_executor;
+	static ThreadPoolExecutor s_threadPool;
+	return s_threadPool;
+}
+
+void FDL::setDefaultExecutor(Executor* p_executor)
+{
+	s_defaultExecutor.store(p_executor);
+}
+
+//	Reads the entry paths of a directory in batches, the blocking half of
+//	Directory::asyncEntries
+class _DirectoryReader
+{
+private:
+
+	void* mp_handle;
+	std::string m_directory;
+public:
+
+	//	Throws File::FileMissingException if path can not be opened
+	explicit _DirectoryReader(const String& path) : mp_handle(_openDirectory_Platform(path)), m_directory(path.c_str())
+	{
+		if(mp_handle == NULL) throw File::FileMissingException("Directory could not be opened");
+		if(m_directory.empty() || m_directory[m_directory.size() - 1] != '/') m_directory += '/';
+	}
+
+	~_DirectoryReader()
+	{
+		_closeDirectory_Platform(mp_handle);
+	}
+
+	_DirectoryReader(const _DirectoryReader&) = delete;
+	_DirectoryReader& operator=(const _DirectoryReader&) = delete;
+
+	//	Replaces paths with up to count full entry paths, copied into p_arena
+	//	if given, false once none are left
+	bool read(std::vector<String>& paths, std::size_t count, Arena* p_arena)
+	{
+		paths.clear();
+		const char* name;
+		while(paths.size() < count && (name = _readDirectory_Platform(mp_handle)) != NULL)
+		{
+			std::size_t directorySize = m_directory.size();
+			std::size_t nameSize = std::strlen(name);
+			if(p_arena != NULL)
+			{
+				char* p_path = static_cast<char*>(p_arena->allocate(directorySize + nameSize + 1, 1));
+				std::memcpy(p_path, m_directory.c_str(), directorySize);
+				std::memcpy(p_path + directorySize, name, nameSize + 1);
+				paths.push_back(String::borrow(p_path, directorySize + nameSize));
+				continue;
+			}
+			std::string path(m_directory);
+			path.append(name, nameSize);
+			paths.push_back(String(path.c_str(), path.size()));
+		}
+		return !paths.empty();
+	}
+};
+
+AsyncGenerator<File> Directory::_asyncEntries(Executor& executor, Arena* p_arena)
+{
+	String directoryPath = toNativePath();
+	std::optional<_DirectoryReader> reader;
+	co_await AsyncOperation<void>(executor, [&reader, &directoryPath]
+	{
+		reader.emplace(directoryPath);
+	});
+
+	//	The paths are moved into the Files, so those from p_arena stay there
+	std::vector<String> paths;
+	while(co_await AsyncOperation<bool>(executor, [&reader, &paths, p_arena] { return reader->read(paths, 64, p_arena); }))
+	{
+		for(std::size_t i = 0; i < paths.size(); ++i) co_yield _fromFullPath(std::move(paths[i]));
+	}
+}
+
+AsyncGenerator<File> Directory::asyncEntries(Executor& executor)
+{
+	return _asyncEntries(executor, NULL);
+}
+
+AsyncGenerator<File> Directory::asyncEntries(Executor& executor, Arena& arena)
+{
+	return _asyncEntries(executor, &arena);
+}
+
+AsyncGenerator<File> Directory::asyncEntries()
+{
+	return _asyncEntries(getDefaultExecutor(), NULL);
+}
+
+#endif /* FDL_HAS_COROUTINES */
@@ -0,0 +1,209 @@
+#include "Platform.hpp"
+#include "CanonicalCache.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+using namespace FDL;
+
+//	Directories resolved by File::canonical, keyed by their absolute path and
+//	split by path hash into independently locked shards. An entry only counts
+//	while its generation is current, so invalidating is a single increment.
+//	The device and inode of the directory are kept to catch changes made
+//	outside FDL, which no generation covers: both the path and its
+//	resolution must still lead to that directory
+class _CanonicalCache
+{
+private:
+
+	struct Entry
+	{
+		std::string canonical;
+		Uint64 device;
+		Uint64 inode;
+		Uint64 generation;
+	};
+
+	struct Shard
+	{
+		std::mutex mutex;
+		std::unordered_map<std::string, Entry> entries;
+	};
+
+	static const std::size_t SHARD_COUNT = 32;
+	static const std::size_t SHARD_CAPACITY = 4096;
+	Shard m_shards[SHARD_COUNT];
+	std::atomic<Uint64> m_generation;
+
+	Shard& _getShard(const std::string& directory)
+	{
+		return m_shards[std::hash<std::string>()(directory) % SHARD_COUNT];
+	}
+public:
+
+	_CanonicalCache() : m_generation(1) {}
+
+	Uint64 getGeneration() const
+	{
+		return m_generation;
+	}
+
+	void invalidate()
+	{
+		++m_generation;
+	}
+
+	bool find(const std::string& directory, std::string& canonical, Uint64& device, Uint64& inode)
+	{
+		Shard& shard = _getShard(directory);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		std::unordered_map<std::string, Entry>::const_iterator found = shard.entries.find(directory);
+		if(found == shard.entries.end() || found->second.generation != m_generation) return false;
+		canonical = found->second.canonical;
+		device = found->second.device;
+		inode = found->second.inode;
+		return true;
+	}
+
+	void erase(const std::string& directory)
+	{
+		Shard& shard = _getShard(directory);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.entries.erase(directory);
+	}
+
+	//	generation is the one current when resolving started, so a resolution
+	//	racing with invalidate() is stored already stale
+	void insert(const std::string& directory, const std::string& canonical, Uint64 device, Uint64 inode,
+		Uint64 generation)
+	{
+		Shard& shard = _getShard(directory);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		if(shard.entries.size() >= SHARD_CAPACITY && shard.entries.find(directory) == shard.entries.end())
+		{
+			Uint64 current = m_generation;
+			for(std::unordered_map<std::string, Entry>::iterator i = shard.entries.begin(); i != shard.entries.end();)
+			{
+				if(i->second.generation != current) i = shard.entries.erase(i);
+				else ++i;
+			}
+			if(shard.entries.size() >= SHARD_CAPACITY) shard.entries.clear();
+		}
+		Entry& entry = shard.entries[directory];
+		entry.canonical = canonical;
+		entry.device = device;
+		entry.inode = inode;
+		entry.generation = generation;
+	}
+};
+
+static _CanonicalCache s_canonicalCache;
+
+//	Splits an absolute path without a trailing slash at its last slash
+static void _splitPath(const std::string& path, std::string& parent, std::string& name)
+{
+	std::size_t slash = path.rfind('/');
+	parent = slash == 0 ? std::string("/") : path.substr(0, slash);
+	name = path.substr(slash + 1);
+}
+
+//	Resolves one name inside an already canonical directory
+static bool _resolveEntry(const std::string& canonicalParent, const std::string& name, std::string& canonical,
+	Uint64& device, Uint64& inode, bool& isDirectory)
+{
+	if(name == ".") canonical = canonicalParent;
+	else if(name == "..")
+	{
+		std::size_t slash = canonicalParent.rfind('/');
+		canonical = slash == 0 ? std::string("/") : canonicalParent.substr(0, slash);
+	}
+	else canonical = canonicalParent == "/" ? "/" + name : canonicalParent + "/" + name;
+
+	bool isLink = false;
+	if(!_getLinkStatus_Platform(canonical.c_str(), device, inode, isLink, isDirectory)) return false;
+	if(!isLink) return true;
+
+	std::string linked = canonical;
+	if(!_resolvePath_Platform(linked.c_str(), canonical)) return false;
+	return _getLinkStatus_Platform(canonical.c_str(), device, inode, isLink, isDirectory);
+}
+
+//	Resolves an absolute directory, walking up only as far as the first
+//	cached directory
+static bool _resolveDirectory(const std::string& directory, std::string& canonical)
+{
+	if(directory == "/")
+	{
+		canonical = directory;
+		return true;
+	}
+
+	//	A hit only stands while directory still leads to the same directory
+	//	and so does its resolution, which a renamed target no longer does.
+	//	At most two stats instead of one per component
+	Uint64 generation = s_canonicalCache.getGeneration();
+	Uint64 device = 0;
+	Uint64 inode = 0;
+	if(s_canonicalCache.find(directory, canonical, device, inode))
+	{
+		Uint64 currentDevice = 0;
+		Uint64 currentInode = 0;
+		if(_getIdentity_Platform(directory.c_str(), currentDevice, currentInode)
+			&& currentDevice == device && currentInode == inode
+			&& (canonical == directory || (_getIdentity_Platform(canonical.c_str(), currentDevice, currentInode)
+			&& currentDevice == device && currentInode == inode))) return true;
+		s_canonicalCache.erase(directory);
+	}
+
+	std::string parent;
+	std::string name;
+	_splitPath(directory, parent, name);
+	std::string canonicalParent;
+	if(!_resolveDirectory(parent, canonicalParent)) return false;
+
+	bool isDirectory = false;
+	if(!_resolveEntry(canonicalParent, name, canonical, device, inode, isDirectory) || !isDirectory) return false;
+	s_canonicalCache.insert(directory, canonical, device, inode, generation);
+	return true;
+}
+
+bool _canonicalize(const char* path, std::string& canonical)
+{
+	std::string absolute;
+	if(path[0] != '/' && !_getWorkingDirectory_Platform(absolute)) return false;
+
+	//	Joined with the working directory and with repeated and trailing
+	//	slashes dropped, so equal directories share a cache key
+	absolute += '/';
+	absolute += path;
+	std::string normalized;
+	normalized.reserve(absolute.size());
+	for(std::size_t i = 0; i < absolute.size(); ++i)
+	{
+		if(absolute[i] == '/' && !normalized.empty() && normalized[normalized.size() - 1] == '/') continue;
+		normalized += absolute[i];
+	}
+	if(normalized.size() > 1 && normalized[normalized.size() - 1] == '/') normalized.erase(normalized.size() - 1);
+	if(normalized == "/")
+	{
+		canonical = normalized;
+		return true;
+	}
+
+	std::string parent;
+	std::string name;
+	_splitPath(normalized, parent, name);
+	std::string canonicalParent;
+	if(!_resolveDirectory(parent, canonicalParent)) return false;
+
+	Uint64 device = 0;
+	Uint64 inode = 0;
+	bool isDirectory = false;
+	return _resolveEntry(canonicalParent, name, canonical, device, inode, isDirectory);
+}
+
+void FDL::invalidateCanonicalCache()
+{
+	s_canonicalCache.invalidate();
+}
@@ -0,0 +1,14 @@
+#ifndef _FDL_CANONICAL_CACHE_H
+#define _FDL_CANONICAL_CACHE_H
+
+#include <string>
+
+///////////////////////////////////////
+//	Canonical Path Cache
+///////////////////////////////////////
+
+//	Resolves path into an absolute path free of links, "." and "..", using
+//	and filling the cache of resolved directories, false if path does not exist
+bool _canonicalize(const char* path, std::string& canonical);
+
+#endif /* _FDL_CANONICAL_CACHE_H */
@@ -0,0 +1,187 @@
+#include "Platform.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace FDL;
+
+Directory::Directory(String path) : File(path.size() == 0 ? String(".") : path) {}
+
+Directory::Directory(String root, String path) : File(root, path) {}
+
+Directory::Directory(const File& root, String path) : File(root, path) {}
+
+Directory::Directory(const Directory& directory) : File(directory) {}
+
+Directory::Directory(Directory&& directory) noexcept : File(std::move(directory)) {}
+
+Directory& Directory::operator=(const Directory& directory)
+{
+	File::operator=(directory);
+	return *this;
+}
+
+Directory& Directory::operator=(Directory&& directory) noexcept
+{
+	File::operator=(std::move(directory));
+	return *this;
+}
+
+ImmutableList<File> Directory::getContainedFiles()
+{
+	std::vector<File> files;
+	_readContainedFiles(files, NULL);
+	return ImmutableList<File>(files.empty() ? NULL : &files[0], files.size(), NULL);
+}
+
+ImmutableList<File> Directory::getContainedFiles(Arena& arena)
+{
+	std::vector<File> files;
+	_readContainedFiles(files, &arena);
+	return ImmutableList<File>(files.empty() ? NULL : &files[0], files.size(), &arena);
+}
+
+void Directory::_readContainedFiles(std::vector<File>& files, Arena* p_arena)
+{
+	String directoryPath = toNativePath();
+	void* p_directory = _openDirectory_Platform(directoryPath);
+	if(p_directory == NULL) throw FileMissingException("Directory could not be opened");
+
+	std::size_t directorySize = directoryPath.size();
+	std::string path;
+	const char* name;
+	try
+	{
+		while((name = _readDirectory_Platform(p_directory)) != NULL)
+		{
+			std::size_t nameSize = std::strlen(name);
+			std::size_t pathSize = directorySize + 1 + nameSize;
+			if(p_arena != NULL)
+			{
+				char* p_path = static_cast<char*>(p_arena->allocate(pathSize + 1, 1));
+				std::memcpy(p_path, directoryPath.c_str(), directorySize);
+				p_path[directorySize] = '/';
+				std::memcpy(p_path + directorySize + 1, name, nameSize + 1);
+				files.push_back(_fromFullPath(String::borrow(p_path, pathSize)));
+				continue;
+			}
+			path.assign(directoryPath.c_str(), directorySize);
+			path += '/';
+			path.append(name, nameSize);
+			files.push_back(_fromFullPath(String(path.c_str(), path.size())));
+		}
+	}
+	catch(...)
+	{
+		_closeDirectory_Platform(p_directory);
+		throw;
+	}
+	_closeDirectory_Platform(p_directory);
+}
+
+FileStream Directory::createTemp()
+{
+	std::string temporaryPath;
+	int descriptor = _createTemporary_Platform(toNativePath(), temporaryPath);
+	if(descriptor < 0) throw FileFailException("Temporary file could not be created");
+	return FileStream(*this, descriptor,
+		temporaryPath.empty() ? String::null_str : String(temporaryPath.c_str(), temporaryPath.size()));
+}
+
+DiskUsage Directory::diskUsage(const DiskUsageOptions& options)
+{
+	DiskUsage usage;
+	if(!_diskUsage_Platform(toNativePath(), options, NULL, usage))
+		throw FileMissingException("Directory could not be opened");
+	return usage;
+}
+
+DiskUsage Directory::diskUsage(const DiskUsageOptions& options, Arena& arena)
+{
+	DiskUsage usage;
+	if(!_diskUsage_Platform(toNativePath(), options, &arena, usage))
+		throw FileMissingException("Directory could not be opened");
+	return usage;
+}
+
+DiskUsage Directory::diskUsage()
+{
+	return diskUsage(DiskUsageOptions());
+}
+
+Uint64 Directory::copyTo(const Directory& destination, const CopyOptions& options)
+{
+	Uint64 copied = 0;
+	Uint64 failed = 0;
+	if(!_copyTree_Platform(toNativePath(), destination.toNativePath(), options, copied, failed))
+		throw FileMissingException("Directory could not be opened");
+	if(failed > 0) throw FileFailException("Directory entries could not be copied");
+	return copied;
+}
+
+Uint64 Directory::copyTo(const Directory& destination)
+{
+	return copyTo(destination, CopyOptions());
+}
+
+void Directory::diff(const Directory& other, const DiffOptions& options, std::function<void(const DiffEntry&)> callback)
+{
+	if(!_diffTree_Platform(toNativePath(), other.toNativePath(), options, callback, NULL))
+		throw FileMissingException("Directory could not be opened");
+}
+
+void Directory::diff(const Directory& other, const DiffOptions& options, std::function<void(const DiffEntry&)> callback,
+	Arena& arena)
+{
+	if(!_diffTree_Platform(toNativePath(), other.toNativePath(), options, callback, &arena))
+		throw FileMissingException("Directory could not be opened");
+}
+
+void Directory::diff(const Directory& other, std::function<void(const DiffEntry&)> callback)
+{
+	diff(other, DiffOptions(), callback);
+}
+
+void Directory::writeSnapshot(const File& snapshotFile)
+{
+	if(!_writeSnapshot_Platform(toNativePath(), snapshotFile.toNativePath()))
+		throw FileMissingException("Directory could not be opened");
+}
+
+void Directory::diffSnapshot(const File& snapshotFile, const DiffOptions& options,
+	std::function<void(const DiffEntry&)> callback)
+{
+	if(!_diffSnapshot_Platform(snapshotFile.toNativePath(), toNativePath(), options, callback, NULL))
+		throw FileMissingException("Directory or snapshot could not be opened");
+}
+
+void Directory::diffSnapshot(const File& snapshotFile, const DiffOptions& options,
+	std::function<void(const DiffEntry&)> callback, Arena& arena)
+{
+	if(!_diffSnapshot_Platform(snapshotFile.toNativePath(), toNativePath(), options, callback, &arena))
+		throw FileMissingException("Directory or snapshot could not be opened");
+}
+
+void Directory::diffSnapshot(const File& snapshotFile, std::function<void(const DiffEntry&)> callback)
+{
+	diffSnapshot(snapshotFile, DiffOptions(), callback);
+}
+
+DiskUsageOptions::DiskUsageOptions()
+	: threadCount(0), deduplicateHardLinks(true), subdirectoryRollups(false)
+{}
+
+DiskUsage::DiskUsage()
+	: path(String::null_str), apparentBytes(0), allocatedBytes(0), fileCount(0), directoryCount(0), skippedCount(0)
+{}
+
+CopyOptions::CopyOptions()
+	: threadCount(0), preserveMode(true), preserveTimes(true), skipUnchanged(false)
+{}
+
+DiffOptions::DiffOptions() : threadCount(0), compareInodes(false), compareContents(false)
+{}
+
+DiffEntry::DiffEntry() : change(MODIFIED), path(String::null_str), directory(false)
+{}
@@ -0,0 +1,27 @@
+#include <FDL/FDL.hpp>
+
+#include <utility>
+
+using namespace FDL;
+
+Exception::Exception(String message) : m_message(std::move(message))
+{}
+
+Exception::~Exception()
+{}
+
+String Exception::what()
+{
+	return m_message;
+}
+
+Exception::operator String() const
+{
+	return m_message;
+}
+
+Exception& Exception::operator=(String message)
+{
+	m_message = std::move(message);
+	return *this;
+}
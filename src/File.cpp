@@ -1,36 +1,232 @@
 #include "Platform.hpp"
+#include "CanonicalCache.hpp"
+
+#include <string>
+#include <utility>
 
 using namespace FDL;
 
-File::File(CStr path) : m_fullPath(convertString(path))
+//	Joins root and path with a single slash, an empty path leaves root as is
+static String _joinPaths(const String& root, const String& path)
 {
-	if(!_verifyString(m_fullPath))
-	{
-		free(m_fullPath)
-		throw BadPathException("m_fullPath is invalid");
-	}
+	if(root.isNullStr() || path.isNullStr()) return String::null_str;
+	if(path.size() == 0) return root;
+	std::string joined(root.c_str(), root.size());
+	if(!joined.empty() && joined[joined.size() - 1] != '/') joined += '/';
+	joined.append(path.c_str(), path.size());
+	return String(joined.c_str(), joined.size());
 }
 
-File::File(CStr root, CStr path)
+//	Normalizes path by the rule PathLiteral follows while compiling, so a
+//	literal and a runtime path of the same text are the same File
+static String _normalize(const String& path)
 {
-	if(sprintf(m_fullPath, "%s/%s", root, path) < 0 || !_verifyString(convertString(m_fullPath)))
+	if(path.isNullStr()) throw BadPathException("Path is null");
+	char buffer[256];
+	std::string large;
+	char* p_normalized = buffer;
+	if(path.size() >= sizeof(buffer))
 	{
-		throw BadPathException("m_fullPath could not be formatted");
+		large.resize(path.size() + 1);
+		p_normalized = &large[0];
 	}
+	std::size_t size = 0;
+	const char* p_error = _normalizePath(path.c_str(), path.size(), p_normalized, size);
+	if(p_error != NULL) throw BadPathException(p_error);
+	return String(p_normalized, size);
+}
+
+File::File(String path) : m_fullPath(_normalize(path)), m_nameOffset(0), m_extensionOffset(0)
+{
+	_locateComponents();
 }
 
-File::File(File root, CStr path): File::File(root.getFullPath(), path) {}
+File::File(String root, String path)
+	: m_fullPath(_normalize(_joinPaths(root, path))), m_nameOffset(0), m_extensionOffset(0)
+{
+	_locateComponents();
+}
+
+File::File(const File& root, String path) : File(root.getFullPath(), path) {}
+
+File::File(const File& file)
+	: m_fullPath(file.m_fullPath), m_nameOffset(file.m_nameOffset), m_extensionOffset(file.m_extensionOffset) {}
+
+File::File(File&& file) noexcept
+	: m_fullPath(std::move(file.m_fullPath)), m_nameOffset(file.m_nameOffset), m_extensionOffset(file.m_extensionOffset)
+{
+	file.m_nameOffset = 0;
+	file.m_extensionOffset = 0;
+}
+
+File::File() : m_fullPath(String::null_str), m_nameOffset(0), m_extensionOffset(0) {}
 
 File::~File()
 {}
 
-String const File::getFullPath() const
+File& File::operator=(const File& file)
+{
+	m_fullPath = file.m_fullPath;
+	m_nameOffset = file.m_nameOffset;
+	m_extensionOffset = file.m_extensionOffset;
+	return *this;
+}
+
+File& File::operator=(File&& file) noexcept
+{
+	m_fullPath = std::move(file.m_fullPath);
+	m_nameOffset = file.m_nameOffset;
+	m_extensionOffset = file.m_extensionOffset;
+	file.m_nameOffset = 0;
+	file.m_extensionOffset = 0;
+	return *this;
+}
+
+File File::_fromFullPath(String fullPath)
+{
+	File file;
+	file.m_fullPath = std::move(fullPath);
+	file._locateComponents();
+	return file;
+}
+
+void File::_locateComponents()
+{
+	const char* p_path = m_fullPath.c_str();
+	std::size_t size = m_fullPath.size();
+	m_nameOffset = size;
+	while(m_nameOffset > 0 && p_path[m_nameOffset - 1] != '/') --m_nameOffset;
+	m_extensionOffset = size;
+	for(std::size_t i = size; i > m_nameOffset + 1; --i)
+	{
+		if(p_path[i - 1] == '.')
+		{
+			m_extensionOffset = i;
+			break;
+		}
+	}
+}
+
+String File::getFullPath() const
 {
 	return String(m_fullPath);
 }
 
-String const File::getExtension() const
+String File::getName() const
+{
+	return String(m_fullPath.c_str() + m_nameOffset, m_fullPath.size() - m_nameOffset);
+}
+
+String File::getExtension() const
+{
+	return String(m_fullPath.c_str() + m_extensionOffset, m_fullPath.size() - m_extensionOffset);
+}
+
+FileStream File::open()
+{
+	return open(isBinary());
+}
+
+FileStream File::open(bool binaryOpen)
+{
+	//	A handle cache hit needs no stat, the file is examined only to tell
+	//	why opening failed
+	FileStream stream(*this, binaryOpen, false);
+	if(stream.open()) return stream;
+	FileStatus status = getStatus();
+	if(!status.exists) throw FileMissingException("File does not exist");
+	if(status.directory) throw FileStream::IsDirectoryException("FileStream can not open a directory");
+	throw FileFailException("FileStream could not be opened");
+}
+
+FileStatus File::getStatus()
+{
+	FileStatus status;
+	_getStatus_Platform(toNativePath(), status);
+	return status;
+}
+
+Uint64 File::getSize()
+{
+	FileStatus status = getStatus();
+	if(!status.exists) throw FileMissingException("File does not exist");
+	return status.size;
+}
+
+bool File::doesExist()
+{
+	return getStatus().exists;
+}
+
+bool File::isDirectory()
+{
+	return getStatus().directory;
+}
+
+bool File::isBinary()
+{
+	static const char* const textExtensions[] = { "txt", "md", "csv", "json", "xml", "html", "ini", "cfg", "log" };
+	String extension = getExtension();
+	for(std::size_t i = 0; i < sizeof(textExtensions) / sizeof(textExtensions[0]); ++i)
+	{
+		if(std::strcmp(extension.c_str(), textExtensions[i]) == 0) return false;
+	}
+	return true;
+}
+
+bool File::create(bool recursive)
+{
+	if(doesExist()) return false;
+	if(!createFileNS(toNativePath(), recursive)) throw FileFailException("File could not be created");
+	return true;
+}
+
+bool File::remove()
+{
+	FileStatus status = getStatus();
+	if(!status.exists) throw FileMissingException("File does not exist");
+	String nativePath = toNativePath();
+	if(!deleteFileNS(nativePath)) return false;
+	invalidateHandleCache(nativePath);
+	if(status.directory) invalidateCanonicalCache();
+	return true;
+}
+
+bool File::move(File newFile, bool recursiveCreate)
+{
+	FileStatus status = getStatus();
+	if(!status.exists) throw FileMissingException("File does not exist");
+	String nativePath = toNativePath();
+	String newNativePath = newFile.toNativePath();
+	if(!_moveFile_Platform(nativePath, newNativePath, recursiveCreate))
+		throw FileFailException("File could not be moved");
+	invalidateHandleCache(nativePath);
+	invalidateHandleCache(newNativePath);
+	if(status.directory) invalidateCanonicalCache();
+	*this = std::move(newFile);
+	return true;
+}
+
+String File::toNativePath() const
+{
+	if(!FDL_IS_WINDOWS) return m_fullPath;
+	String nativePath(m_fullPath);
+	for(std::size_t i = 0; i < nativePath.size(); ++i)
+	{
+		if(nativePath.c_str()[i] == '/') *nativePath[static_cast<int>(i)] = '\\';
+	}
+	return nativePath;
+}
+
+FileStatus::FileStatus() : exists(false), directory(false), size(0), modifiedTime(0)
+{}
+
+File File::canonical() const
 {
-	char* path = strchr(m_fullPath, '.');
-	return String(++path);
+	std::string canonicalPath;
+	if(!_canonicalize(toNativePath(), canonicalPath)) throw FileMissingException("File does not exist");
+	File canonicalFile(*this);
+	canonicalFile.m_fullPath = String(canonicalPath.c_str(), canonicalPath.size());
+	canonicalFile._locateComponents();
+	return canonicalFile;
 }
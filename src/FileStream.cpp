@@ -0,0 +1,302 @@
+#include "Platform.hpp"
+#include "HandleCache.hpp"
+#include "StreamPipeline.hpp"
+
+#include <utility>
+
+using namespace FDL;
+
+FileStream::FileStream(File file)
+	: m_file(std::move(file)), m_fileStream(), m_binary(false), mp_pipeline(NULL), m_handlePosition(0),
+	m_writeFailed(false), m_temporaryPath(String::null_str), m_temporary(false)
+{
+	if(m_file.isDirectory()) throw IsDirectoryException("FileStream can not open a directory");
+	m_binary = m_file.isBinary();
+}
+
+FileStream::FileStream(File file, bool handleBinary)
+	: m_file(std::move(file)), m_fileStream(), m_binary(handleBinary), mp_pipeline(NULL), m_handlePosition(0),
+	m_writeFailed(false), m_temporaryPath(String::null_str), m_temporary(false)
+{
+	if(m_file.isDirectory()) throw IsDirectoryException("FileStream can not open a directory");
+}
+
+FileStream::FileStream(File file, bool handleBinary, bool checkDirectory)
+	: m_file(std::move(file)), m_fileStream(), m_binary(handleBinary), mp_pipeline(NULL), m_handlePosition(0),
+	m_writeFailed(false), m_temporaryPath(String::null_str), m_temporary(false)
+{
+	if(checkDirectory && m_file.isDirectory()) throw IsDirectoryException("FileStream can not open a directory");
+}
+
+FileStream::FileStream(FileStream&& stream) noexcept
+	: m_file(std::move(stream.m_file)), m_fileStream(), m_binary(stream.m_binary), mp_pipeline(NULL), m_handlePosition(0),
+	m_writeFailed(false), m_temporaryPath(String::null_str), m_temporary(false)
+{
+	//	The helper thread of a pipeline uses the stream and the handle in
+	//	place, so it is stopped before they move
+	stream.disablePipelining();
+	m_fileStream = std::move(stream.m_fileStream);
+	m_handle = std::move(stream.m_handle);
+	m_handlePosition = stream.m_handlePosition;
+	m_writeFailed = stream.m_writeFailed;
+	m_temporaryPath = std::move(stream.m_temporaryPath);
+	m_temporary = stream.m_temporary;
+	stream.m_temporary = false;
+}
+
+FileStream::FileStream(const Directory& directory, int descriptor, String temporaryPath)
+	: m_file(directory), m_fileStream(), m_binary(true), mp_pipeline(NULL),
+	m_handle(std::make_shared<_CachedHandle>(descriptor, true)), m_handlePosition(0),
+	m_writeFailed(false), m_temporaryPath(std::move(temporaryPath)), m_temporary(true)
+{}
+
+FileStream::~FileStream()
+{
+	close();
+}
+
+FileStream& FileStream::operator=(FileStream&& stream) noexcept
+{
+	if(this == &stream) return *this;
+	close();
+	stream.disablePipelining();
+	m_file = std::move(stream.m_file);
+	m_fileStream = std::move(stream.m_fileStream);
+	m_binary = stream.m_binary;
+	m_handle = std::move(stream.m_handle);
+	m_handlePosition = stream.m_handlePosition;
+	m_writeFailed = stream.m_writeFailed;
+	m_temporaryPath = std::move(stream.m_temporaryPath);
+	m_temporary = stream.m_temporary;
+	stream.m_temporary = false;
+	return *this;
+}
+
+bool FileStream::open()
+{
+	if(isOpen()) return true;
+	String nativePath = m_file.toNativePath();
+
+	//	Files that can not be written are still opened for reading
+	m_handle = _acquireHandle(nativePath);
+	if(m_handle)
+	{
+		m_handlePosition = 0;
+		m_writeFailed = false;
+		return true;
+	}
+	std::ios_base::openmode mode = m_binary ? std::ios_base::binary : std::ios_base::openmode();
+	m_fileStream.open(nativePath.c_str(), mode | std::ios_base::in | std::ios_base::out);
+	if(!m_fileStream.is_open())
+	{
+		//	Only opening a directory for reading alone succeeds
+		if(m_file.isDirectory()) return false;
+		m_fileStream.clear();
+		m_fileStream.open(nativePath.c_str(), mode | std::ios_base::in);
+	}
+	return isOpen();
+}
+
+bool FileStream::isOpen()
+{
+	return m_handle || m_fileStream.is_open();
+}
+
+void FileStream::close()
+{
+	disablePipelining();
+	m_handle.reset();
+	if(m_temporary && !m_temporaryPath.isNullStr()) deleteFileNS(m_temporaryPath);
+	m_temporary = false;
+	if(m_fileStream.is_open()) m_fileStream.close();
+}
+
+std::fstream* FileStream::getStream()
+{
+	disablePipelining();
+	return m_fileStream.is_open() ? &m_fileStream : NULL;
+}
+
+bool FileStream::enableReadAhead(std::size_t bufferSize, std::size_t bufferCount)
+{
+	disablePipelining();
+	if(!isOpen()) return false;
+	std::streamoff position = m_handle ? static_cast<std::streamoff>(m_handlePosition) : static_cast<std::streamoff>(m_fileStream.tellg());
+	mp_pipeline = new _StreamPipeline(_StreamPipeline::READ_AHEAD, bufferSize, bufferCount,
+		position < 0 ? 0 : static_cast<Int64>(position),
+		[this](char* buffer, Int64 size) { return _readDirect(buffer, size); },
+		[this](Bytes data, Int64 size) { return _writeDirect(data, size); });
+	return true;
+}
+
+bool FileStream::enableWriteBehind(std::size_t bufferSize, std::size_t bufferCount)
+{
+	disablePipelining();
+	if(!isOpen()) return false;
+	std::streamoff position = m_handle ? static_cast<std::streamoff>(m_handlePosition) : static_cast<std::streamoff>(m_fileStream.tellp());
+	mp_pipeline = new _StreamPipeline(_StreamPipeline::WRITE_BEHIND, bufferSize, bufferCount,
+		position < 0 ? 0 : static_cast<Int64>(position),
+		[this](char* buffer, Int64 size) { return _readDirect(buffer, size); },
+		[this](Bytes data, Int64 size) { return _writeDirect(data, size); });
+	return true;
+}
+
+bool FileStream::disablePipelining()
+{
+	if(mp_pipeline == NULL) return true;
+	_StreamPipeline* p_pipeline = static_cast<_StreamPipeline*>(mp_pipeline);
+	mp_pipeline = NULL;
+	bool flushed = p_pipeline->stop();
+	if(p_pipeline->getMode() == _StreamPipeline::READ_AHEAD && m_handle)
+		m_handlePosition = p_pipeline->getPosition();
+	else if(p_pipeline->getMode() == _StreamPipeline::READ_AHEAD)
+	{
+		m_fileStream.clear();
+		m_fileStream.seekg(p_pipeline->getPosition());
+	}
+	delete p_pipeline;
+	return flushed;
+}
+
+bool FileStream::isPipelined() const
+{
+	return mp_pipeline != NULL;
+}
+
+bool FileStream::publish(String name)
+{
+	if(!m_temporary || !disablePipelining() || m_writeFailed) return false;
+	File published(m_file, name);
+	String nativePath = published.toNativePath();
+	int descriptor = static_cast<_CachedHandle*>(m_handle.get())->descriptor;
+	if(!_publishTemporary_Platform(descriptor, m_temporaryPath.isNullStr() ? NULL : m_temporaryPath.c_str(), nativePath))
+		return false;
+	invalidateHandleCache(nativePath);
+	m_file = std::move(published);
+	m_temporaryPath = String::null_str;
+	m_temporary = false;
+	return true;
+}
+
+bool FileStream::isTemporary() const
+{
+	return m_temporary;
+}
+
+Int64 FileStream::_readDirect(char* buffer, Int64 size)
+{
+	if(m_handle)
+	{
+		int descriptor = static_cast<_CachedHandle*>(m_handle.get())->descriptor;
+		Int64 readSize = _readAt_Platform(descriptor, buffer, size, m_handlePosition);
+		if(readSize > 0) m_handlePosition += readSize;
+		return readSize;
+	}
+	m_fileStream.read(buffer, size);
+	Int64 readSize = m_fileStream.gcount();
+	if(m_fileStream.eof()) m_fileStream.clear();
+	else if(m_fileStream.fail()) return -1;
+	return readSize;
+}
+
+bool FileStream::_writeDirect(Bytes data, Int64 size)
+{
+	if(m_handle)
+	{
+		int descriptor = static_cast<_CachedHandle*>(m_handle.get())->descriptor;
+		if(!_writeAt_Platform(descriptor, data, size, m_handlePosition))
+		{
+			m_writeFailed = true;
+			return false;
+		}
+		m_handlePosition += size;
+		return true;
+	}
+	m_fileStream.write(data, size);
+	return !m_fileStream.fail();
+}
+
+void FileStream::write(Bytes data, Int64 size)
+{
+	if(size < 0) size = static_cast<Int64>(std::strlen(data));
+	_StreamPipeline* p_pipeline = static_cast<_StreamPipeline*>(mp_pipeline);
+	if(p_pipeline != NULL && p_pipeline->getMode() == _StreamPipeline::WRITE_BEHIND)
+	{
+		p_pipeline->write(data, size);
+		return;
+	}
+	disablePipelining();
+	_writeDirect(data, size);
+}
+
+Int64 FileStream::read(char* buffer, Int64 size)
+{
+	_StreamPipeline* p_pipeline = static_cast<_StreamPipeline*>(mp_pipeline);
+	if(p_pipeline != NULL && p_pipeline->getMode() == _StreamPipeline::READ_AHEAD)
+		return p_pipeline->read(buffer, size);
+	disablePipelining();
+	Int64 readSize = _readDirect(buffer, size);
+	return readSize < 0 ? 0 : readSize;
+}
+
+void FileStream::seekWrite(Int64 position)
+{
+	disablePipelining();
+	if(m_handle)
+	{
+		_seekHandle(position);
+		return;
+	}
+	m_fileStream.seekp(0, std::ios_base::end);
+	if(position > static_cast<Int64>(m_fileStream.tellp()))
+		throw EOSException("Writer position is beyond end of stream");
+	m_fileStream.seekp(position);
+}
+
+Uint64 FileStream::tellWrite()
+{
+	if(mp_pipeline != NULL) return static_cast<Uint64>(static_cast<_StreamPipeline*>(mp_pipeline)->getPosition());
+	if(m_handle) return static_cast<Uint64>(m_handlePosition);
+	std::streamoff position = m_fileStream.tellp();
+	if(position < 0) throw File::FileSizeFailureException("Writer position could not be retrieved");
+	return static_cast<Uint64>(position);
+}
+
+void FileStream::seekRead(Int64 position)
+{
+	disablePipelining();
+	if(m_handle)
+	{
+		_seekHandle(position);
+		return;
+	}
+	m_fileStream.seekg(0, std::ios_base::end);
+	if(position > static_cast<Int64>(m_fileStream.tellg()))
+		throw EOSException("Reader position is beyond end of stream");
+	m_fileStream.seekg(position);
+}
+
+Int64 FileStream::tellRead()
+{
+	if(mp_pipeline != NULL) return static_cast<_StreamPipeline*>(mp_pipeline)->getPosition();
+	if(m_handle) return m_handlePosition;
+	std::streamoff position = m_fileStream.tellg();
+	if(position < 0) throw File::FileSizeFailureException("Reader position could not be retrieved");
+	return static_cast<Int64>(position);
+}
+
+bool FileStream::flush()
+{
+	if(mp_pipeline != NULL && !static_cast<_StreamPipeline*>(mp_pipeline)->flush()) return false;
+	if(m_handle) return !m_writeFailed;
+	m_fileStream.flush();
+	return !m_fileStream.fail();
+}
+
+void FileStream::_seekHandle(Int64 position)
+{
+	int descriptor = static_cast<_CachedHandle*>(m_handle.get())->descriptor;
+	if(position > _getDescriptorSize_Platform(descriptor)) throw EOSException("Position is beyond end of stream");
+	m_handlePosition = position;
+	m_writeFailed = false;
+}
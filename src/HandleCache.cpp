@@ -0,0 +1,173 @@
+#include "Platform.hpp"
+#include "HandleCache.hpp"
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+using namespace FDL;
+
+//	The handles are split by path hash into shards that are locked
+//	independently, each shard keeps its handles in LRU order. The budget
+//	holds for all shards together, so eviction moves on to the next shard
+//	when the one of the newest handle has nothing older to close
+class _HandleCache
+{
+private:
+
+	typedef std::pair<std::string, std::shared_ptr<_CachedHandle> > Entry;
+
+	struct Shard
+	{
+		std::mutex mutex;
+		std::list<Entry> entries;
+		std::unordered_map<std::string, std::list<Entry>::iterator> index;
+	};
+
+	static const std::size_t SHARD_COUNT = 16;
+	Shard m_shards[SHARD_COUNT];
+	std::atomic<bool> m_enabled;
+	std::atomic<std::size_t> m_budget;
+	std::atomic<std::size_t> m_count;
+
+	static std::size_t _getShardIndex(const std::string& path)
+	{
+		return std::hash<std::string>()(path) % SHARD_COUNT;
+	}
+
+	void _evict(std::size_t firstShard)
+	{
+		for(std::size_t i = 0; i < SHARD_COUNT && m_count > m_budget; ++i)
+		{
+			Shard& shard = m_shards[(firstShard + i) % SHARD_COUNT];
+			std::size_t keep = i == 0 ? 1 : 0;
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			while(shard.entries.size() > keep && m_count > m_budget)
+			{
+				shard.index.erase(shard.entries.back().first);
+				shard.entries.pop_back();
+				--m_count;
+			}
+		}
+	}
+
+public:
+
+	_HandleCache() : m_enabled(false), m_budget(1), m_count(0) {}
+
+	void enable(Uint32 handleBudget)
+	{
+		m_budget = handleBudget == 0 ? 1 : handleBudget;
+		m_enabled = true;
+		_evict(0);
+	}
+
+	void disable()
+	{
+		m_enabled = false;
+		for(std::size_t i = 0; i < SHARD_COUNT; ++i)
+		{
+			std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+			m_count -= m_shards[i].entries.size();
+			m_shards[i].index.clear();
+			m_shards[i].entries.clear();
+		}
+	}
+
+	std::shared_ptr<_CachedHandle> acquire(const std::string& path)
+	{
+		if(!m_enabled) return std::shared_ptr<_CachedHandle>();
+		std::size_t shardIndex = _getShardIndex(path);
+		Shard& shard = m_shards[shardIndex];
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			std::unordered_map<std::string, std::list<Entry>::iterator>::iterator found = shard.index.find(path);
+			if(found != shard.index.end())
+			{
+				shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+				return found->second->second;
+			}
+		}
+
+		//	Opened without the lock, a concurrent miss on the same path keeps
+		//	whichever handle was cached first
+		bool writable = true;
+		int descriptor = _openDescriptor_Platform(path.c_str(), true);
+		if(descriptor < 0)
+		{
+			writable = false;
+			descriptor = _openDescriptor_Platform(path.c_str(), false);
+		}
+		if(descriptor < 0) return std::shared_ptr<_CachedHandle>();
+		std::shared_ptr<_CachedHandle> p_handle = std::make_shared<_CachedHandle>(descriptor, writable);
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			std::unordered_map<std::string, std::list<Entry>::iterator>::iterator found = shard.index.find(path);
+			if(found != shard.index.end()) return found->second->second;
+			shard.entries.push_front(Entry(path, p_handle));
+			shard.index[path] = shard.entries.begin();
+			++m_count;
+		}
+		_evict(shardIndex);
+		return p_handle;
+	}
+
+	//	The mode that worked goes with the handle, a file made writable
+	//	since is opened for writing again on the next miss
+	void invalidate(const std::string& path)
+	{
+		Shard& shard = m_shards[_getShardIndex(path)];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		std::unordered_map<std::string, std::list<Entry>::iterator>::iterator found = shard.index.find(path);
+		if(found == shard.index.end()) return;
+		shard.entries.erase(found->second);
+		shard.index.erase(found);
+		--m_count;
+	}
+
+	std::size_t getCount() const
+	{
+		return m_count;
+	}
+};
+
+static _HandleCache s_handleCache;
+
+_CachedHandle::_CachedHandle(int descriptor, bool writable) : descriptor(descriptor), writable(writable)
+{}
+
+_CachedHandle::~_CachedHandle()
+{
+	_closeDescriptor_Platform(descriptor);
+}
+
+std::shared_ptr<_CachedHandle> _acquireHandle(const char* path)
+{
+	return s_handleCache.acquire(path);
+}
+
+std::size_t _getCachedHandleCount()
+{
+	return s_handleCache.getCount();
+}
+
+bool FDL::enableHandleCache(Uint32 handleBudget)
+{
+	if(!FDL_IS_POSIX) return false;
+	s_handleCache.enable(handleBudget);
+	return true;
+}
+
+void FDL::disableHandleCache()
+{
+	s_handleCache.disable();
+}
+
+void FDL::invalidateHandleCache(String path)
+{
+	if(path.isNullStr()) return;
+	s_handleCache.invalidate(path.c_str());
+}
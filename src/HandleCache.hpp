@@ -0,0 +1,35 @@
+#ifndef _FDL_HANDLE_CACHE_H
+#define _FDL_HANDLE_CACHE_H
+
+#include <FDL/FDL.hpp>
+
+#include <memory>
+
+///////////////////////////////////////
+//	Handle Cache
+///////////////////////////////////////
+
+//	A descriptor shared between the cache and every FileStream of one path,
+//	closed once the last of them lets go of it
+struct _CachedHandle
+{
+	int descriptor;
+	bool writable;
+
+	_CachedHandle(int descriptor, bool writable);
+	~_CachedHandle();
+
+	_CachedHandle(const _CachedHandle&) = delete;
+	_CachedHandle& operator=(const _CachedHandle&) = delete;
+};
+
+//	Retrieves the shared handle of path, opening it on a miss for reading
+//	and writing, or for reading alone if writing is refused. The handle
+//	keeps the mode that worked, so a hit never retries the refused one.
+//	Empty if the cache is disabled or path can not be opened at all
+std::shared_ptr<_CachedHandle> _acquireHandle(const char* path);
+
+//	Retrieves how many handles the cache holds open
+std::size_t _getCachedHandleCount();
+
+#endif /* _FDL_HANDLE_CACHE_H */
@@ -1,32 +1,37 @@
 #include "Platform.hpp"
 
+#include <string>
+
 using namespace FDL;
 
 // TODO: Create Generic callable functions
 // Example: CreateFile would exist, but is first handled outside of OS calls, then handed to a _CreateFile function call
 
-bool isWindows()
+bool FDL::isWindows()
 {
 	return FDL_IS_WINDOWS;
 }
 
-bool isPosix()
+bool FDL::isPosix()
 {
 	return FDL_IS_POSIX;
 }
 
-String convertString(String originalStr)
+String FDL::convertString(String originalStr)
 {
-	if(originalStr[originalStr.size()-1] == '/') return String::null_str;
-	return _convertString_Platform(originalStr);
+	if(originalStr.isNullStr()) return String::null_str;
+	std::string normalized(originalStr.size() + 1, '\0');
+	std::size_t size = 0;
+	if(_normalizePath(originalStr.c_str(), originalStr.size(), &normalized[0], size) != NULL) return String::null_str;
+	return String(normalized.c_str(), size);
 }
 
-bool createFileNS(String path, bool recursive)
+bool FDL::createFileNS(String path, bool recursive)
 {
 	return _createFile_Platform(path, recursive);
 }
 
-bool deleteFileNS(String path)
+bool FDL::deleteFileNS(String path)
 {
 	return _deleteFile_Platform(path);
 }
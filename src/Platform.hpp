@@ -1,15 +1,20 @@
+#ifndef _FDL_PLATFORM_H
+#define _FDL_PLATFORM_H
+
 #ifndef _FDL_NO_CONFIG
 #	include "FDL_Config.hpp"
 #endif
 
+//	Only the declarations, the definitions live in Platform_Posix.cpp and
+//	Platform_Windows.cpp, each compiled on its own platform
+#include "Platform_Declare.hpp"
+
 #ifdef _FDL_POSIX
-#	include "Platform_Posix.hpp"
 #	define FDL_IS_POSIX true
 #	define FDL_IS_WINDOWS false
 #elif defined(_FDL_WINDOWS)
-#	include "Platform_Windows.hpp"
 #	define FDL_IS_POSIX false
 #	define FDL_IS_WINDOWS true
-#else
-#	include "Platform_Declare"
 #endif
+
+#endif /* _FDL_PLATFORM_H */
@@ -5,6 +5,7 @@
 
 #include <cstring>
 #include <cstdio>
+#include <string>
 
 #if !defined(_FDL_POSIX) && !defined(_FDL_WINDOWS)
 #	error "Filesystem Type not designated, FDL failed"
@@ -14,14 +15,72 @@
 //	Platform Declarations
 ///////////////////////////////////////
 
-//	Converts String to acceptable path string
-const char* _convertString_Platform(const char* orignalString);
 //	Creates file based on the path, supports recursion
 bool _createFile_Platform(const char* path, bool recursive);
 //	Deletes a file based on path
 bool _deleteFile_Platform(const char* path);
 
-//	Verify a string can be inserted as a path
-bool _verifyString(const char* string);
+//	Fills status for path, false if it does not exist
+bool _getStatus_Platform(const char* path, FDL::FileStatus& status);
+
+//	Opens a directory for reading its entry names, NULL if it can not be opened
+void* _openDirectory_Platform(const char* path);
+//	Reads the next entry name, skipping "." and "..", NULL once none are left
+const char* _readDirectory_Platform(void* p_directory);
+//	Closes a directory opened by _openDirectory_Platform
+void _closeDirectory_Platform(void* p_directory);
+
+//	Fills the identity of path without following a final link, false if it does not exist
+bool _getLinkStatus_Platform(const char* path, FDL::Uint64& device, FDL::Uint64& inode,
+	bool& isLink, bool& isDirectory);
+//	Fills the identity of what path refers to after following every link,
+//	false if it does not exist
+bool _getIdentity_Platform(const char* path, FDL::Uint64& device, FDL::Uint64& inode);
+//	Resolves every link, "." and ".." in path, false if it does not exist
+bool _resolvePath_Platform(const char* path, std::string& resolved);
+//	Retrieves the absolute path of the working directory
+bool _getWorkingDirectory_Platform(std::string& directory);
+
+//	Opens path for reading, and for writing too if write is set, -1 on
+//	failure or if path is a directory
+int _openDescriptor_Platform(const char* path, bool write);
+//	Closes a descriptor from _openDescriptor_Platform
+void _closeDescriptor_Platform(int descriptor);
+//	Reads up to size bytes at offset without moving a shared position, -1 on failure
+FDL::Int64 _readAt_Platform(int descriptor, char* buffer, FDL::Int64 size, FDL::Int64 offset);
+//	Writes all of size bytes at offset without moving a shared position
+bool _writeAt_Platform(int descriptor, const char* data, FDL::Int64 size, FDL::Int64 offset);
+//	Retrieves the byte size of an open descriptor, -1 on failure
+FDL::Int64 _getDescriptorSize_Platform(int descriptor);
+//	Moves a file, creating the parents of newPath when recursive
+bool _moveFile_Platform(const char* path, const char* newPath, bool recursive);
+
+//	Opens an unnamed file in directory, or a uniquely named one when the
+//	filesystem has no unnamed files, temporaryPath is left empty if unnamed,
+//	-1 on failure
+int _createTemporary_Platform(const char* directory, std::string& temporaryPath);
+//	Links a file from _createTemporary_Platform to path without replacing
+//	an existing file, temporaryPath is NULL if unnamed
+bool _publishTemporary_Platform(int descriptor, const char* temporaryPath, const char* path);
+
+//	Totals the space used below path, false if path can not be opened
+bool _diskUsage_Platform(const char* path, const FDL::DiskUsageOptions& options, FDL::Arena* p_arena,
+	FDL::DiskUsage& usage);
+//	Copies the tree at source into destination, false if source can not be opened
+bool _copyTree_Platform(const char* source, const char* destination, const FDL::CopyOptions& options,
+	FDL::Uint64& copied, FDL::Uint64& failed);
+//	Reports the differences between the trees at path and otherPath, with
+//	the reported paths copied into p_arena if given, false if either can not
+//	be opened, throws if anything below them can not be read
+bool _diffTree_Platform(const char* path, const char* otherPath, const FDL::DiffOptions& options,
+	const std::function<void(const FDL::DiffEntry&)>& callback, FDL::Arena* p_arena);
+//	Records the tree at path into the snapshot file snapshotPath, false if
+//	path can not be opened
+bool _writeSnapshot_Platform(const char* path, const char* snapshotPath);
+//	Reports how the tree at path differs from the snapshot at snapshotPath,
+//	with the reported paths copied into p_arena if given, false if either can
+//	not be opened
+bool _diffSnapshot_Platform(const char* snapshotPath, const char* path, const FDL::DiffOptions& options,
+	const std::function<void(const FDL::DiffEntry&)>& callback, FDL::Arena* p_arena);
 
 #endif /* _FDL_PLATFORM_DECLARE_H */
@@ -0,0 +1,1313 @@
+#include "Platform.hpp"
+
+#ifdef _FDL_POSIX
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#	include <linux/fs.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "TaskPool.hpp"
+
+//	Creates every missing parent directory of path
+static bool _createParents(const char* path)
+{
+	std::string parents(path);
+	for(std::size_t slash = parents.find('/', 1); slash != std::string::npos; slash = parents.find('/', slash + 1))
+	{
+		parents[slash] = '\0';
+		if(mkdir(parents.c_str(), 0777) != 0 && errno != EEXIST) return false;
+		parents[slash] = '/';
+	}
+	return true;
+}
+
+bool _createFile_Platform(const char* path, bool recursive)
+{
+	if(recursive && !_createParents(path)) return false;
+	int fd = open(path, O_WRONLY | O_CREAT | O_CLOEXEC, 0666);
+	if(fd < 0) return false;
+	close(fd);
+	return true;
+}
+
+bool _deleteFile_Platform(const char* path)
+{
+	if(unlink(path) == 0) return true;
+	if(errno == EISDIR || errno == EPERM) return rmdir(path) == 0;
+	return false;
+}
+
+///////////////////////////////////////
+//	Directory Walking
+///////////////////////////////////////
+
+//	Whether name is the "." or ".." entry
+static bool _isDotEntry(const char* name)
+{
+	return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+//	Appends name to the directory path
+static std::string _joinPath(const std::string& directory, const char* name)
+{
+	if(!directory.empty() && directory[directory.size() - 1] == '/') return directory + name;
+	return directory + '/' + name;
+}
+
+//	Copies directory + '/' + name into arena
+static const char* _joinPath(FDL::Arena& arena, const char* directory, const char* name)
+{
+	std::size_t directorySize = std::strlen(directory);
+	std::size_t nameSize = std::strlen(name);
+	bool slash = directorySize > 0 && directory[directorySize - 1] == '/';
+	std::size_t size = directorySize + (slash ? 0 : 1) + nameSize;
+	char* p_path = static_cast<char*>(arena.allocate(size + 1, 1));
+	std::memcpy(p_path, directory, directorySize);
+	if(!slash) p_path[directorySize] = '/';
+	std::memcpy(p_path + size - nameSize, name, nameSize + 1);
+	return p_path;
+}
+
+bool _getStatus_Platform(const char* path, FDL::FileStatus& status)
+{
+	struct stat fileStatus;
+	if(stat(path, &fileStatus) != 0) return false;
+	status.exists = true;
+	status.directory = S_ISDIR(fileStatus.st_mode);
+	status.size = static_cast<FDL::Uint64>(fileStatus.st_size);
+	status.modifiedTime = static_cast<FDL::Int64>(fileStatus.st_mtim.tv_sec) * 1000000000LL + fileStatus.st_mtim.tv_nsec;
+	return true;
+}
+
+void* _openDirectory_Platform(const char* path)
+{
+	return opendir(path);
+}
+
+const char* _readDirectory_Platform(void* p_directory)
+{
+	struct dirent* p_entry;
+	while((p_entry = readdir(static_cast<DIR*>(p_directory))) != NULL)
+	{
+		if(!_isDotEntry(p_entry->d_name)) return p_entry->d_name;
+	}
+	return NULL;
+}
+
+void _closeDirectory_Platform(void* p_directory)
+{
+	closedir(static_cast<DIR*>(p_directory));
+}
+
+bool _moveFile_Platform(const char* path, const char* newPath, bool recursive)
+{
+	if(recursive && !_createParents(newPath)) return false;
+	return rename(path, newPath) == 0;
+}
+
+bool _getLinkStatus_Platform(const char* path, FDL::Uint64& device, FDL::Uint64& inode,
+	bool& isLink, bool& isDirectory)
+{
+	struct stat status;
+	if(lstat(path, &status) != 0) return false;
+	device = static_cast<FDL::Uint64>(status.st_dev);
+	inode = static_cast<FDL::Uint64>(status.st_ino);
+	isLink = S_ISLNK(status.st_mode);
+	isDirectory = S_ISDIR(status.st_mode);
+	return true;
+}
+
+bool _getIdentity_Platform(const char* path, FDL::Uint64& device, FDL::Uint64& inode)
+{
+	struct stat status;
+	if(stat(path, &status) != 0) return false;
+	device = static_cast<FDL::Uint64>(status.st_dev);
+	inode = static_cast<FDL::Uint64>(status.st_ino);
+	return true;
+}
+
+bool _resolvePath_Platform(const char* path, std::string& resolved)
+{
+	char buffer[PATH_MAX];
+	if(realpath(path, buffer) == NULL) return false;
+	resolved = buffer;
+	return true;
+}
+
+bool _getWorkingDirectory_Platform(std::string& directory)
+{
+	char buffer[PATH_MAX];
+	if(getcwd(buffer, sizeof(buffer)) == NULL) return false;
+	directory = buffer;
+	return true;
+}
+
+int _openDescriptor_Platform(const char* path, bool write)
+{
+	int descriptor = open(path, (write ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+	if(descriptor < 0 || write) return descriptor;
+
+	//	Only a read-only open succeeds on a directory
+	struct stat status;
+	if(fstat(descriptor, &status) != 0 || S_ISDIR(status.st_mode))
+	{
+		close(descriptor);
+		return -1;
+	}
+	return descriptor;
+}
+
+void _closeDescriptor_Platform(int descriptor)
+{
+	close(descriptor);
+}
+
+FDL::Int64 _readAt_Platform(int descriptor, char* buffer, FDL::Int64 size, FDL::Int64 offset)
+{
+	for(;;)
+	{
+		ssize_t readSize = pread(descriptor, buffer, static_cast<std::size_t>(size), static_cast<off_t>(offset));
+		if(readSize >= 0 || errno != EINTR) return static_cast<FDL::Int64>(readSize);
+	}
+}
+
+bool _writeAt_Platform(int descriptor, const char* data, FDL::Int64 size, FDL::Int64 offset)
+{
+	while(size > 0)
+	{
+		ssize_t written = pwrite(descriptor, data, static_cast<std::size_t>(size), static_cast<off_t>(offset));
+		if(written < 0)
+		{
+			if(errno == EINTR) continue;
+			return false;
+		}
+		data += written;
+		size -= written;
+		offset += written;
+	}
+	return true;
+}
+
+FDL::Int64 _getDescriptorSize_Platform(int descriptor)
+{
+	struct stat status;
+	if(fstat(descriptor, &status) != 0) return -1;
+	return static_cast<FDL::Int64>(status.st_size);
+}
+
+///////////////////////////////////////
+//	Temporary Files
+///////////////////////////////////////
+
+//	Reads the umask without changing it, where /proc reports it, since
+//	setting it briefly would race with files created on other threads
+static mode_t _getUmask()
+{
+	FILE* p_status = fopen("/proc/self/status", "re");
+	if(p_status != NULL)
+	{
+		char line[128];
+		unsigned int mask;
+		while(fgets(line, sizeof(line), p_status) != NULL)
+		{
+			if(sscanf(line, "Umask: %o", &mask) == 1)
+			{
+				fclose(p_status);
+				return static_cast<mode_t>(mask);
+			}
+		}
+		fclose(p_status);
+	}
+	mode_t mask = umask(022);
+	umask(mask);
+	return mask;
+}
+
+int _createTemporary_Platform(const char* directory, std::string& temporaryPath)
+{
+	temporaryPath.clear();
+#ifdef O_TMPFILE
+	int unnamed = open(directory, O_TMPFILE | O_RDWR | O_CLOEXEC, 0666);
+	if(unnamed >= 0) return unnamed;
+	//	Kernels and filesystems without O_TMPFILE report one of these
+	if(errno != EOPNOTSUPP && errno != EISDIR && errno != EINVAL) return -1;
+#endif
+	std::string pattern = _joinPath(directory, ".fdl-temp-XXXXXX");
+	std::vector<char> name(pattern.begin(), pattern.end());
+	name.push_back('\0');
+	int descriptor = mkostemp(&name[0], O_CLOEXEC);
+	if(descriptor < 0) return -1;
+
+	//	mkostemp creates 0600, the published file gets the mode open would
+	//	have given it like an O_TMPFILE one
+	if(fchmod(descriptor, 0666 & ~_getUmask()) != 0)
+	{
+		close(descriptor);
+		unlink(&name[0]);
+		return -1;
+	}
+	temporaryPath = &name[0];
+	return descriptor;
+}
+
+bool _publishTemporary_Platform(int descriptor, const char* temporaryPath, const char* path)
+{
+	if(temporaryPath != NULL)
+	{
+		if(link(temporaryPath, path) != 0) return false;
+		unlink(temporaryPath);
+		return true;
+	}
+
+	//	Linking through /proc needs no privileges, AT_EMPTY_PATH covers
+	//	systems without /proc mounted
+	char procPath[64];
+	snprintf(procPath, sizeof(procPath), "/proc/self/fd/%d", descriptor);
+	if(linkat(AT_FDCWD, procPath, AT_FDCWD, path, AT_SYMLINK_FOLLOW) == 0) return true;
+#ifdef AT_EMPTY_PATH
+	if(errno != EEXIST && linkat(descriptor, "", AT_FDCWD, path, AT_EMPTY_PATH) == 0) return true;
+#endif
+	return false;
+}
+
+///////////////////////////////////////
+//	Disk Usage
+///////////////////////////////////////
+
+//	Set of (device, inode) pairs split into independently locked shards
+class _InodeSet
+{
+private:
+
+	struct Key
+	{
+		dev_t device;
+		ino_t inode;
+
+		bool operator==(const Key& rhs) const
+		{
+			return device == rhs.device && inode == rhs.inode;
+		}
+	};
+
+	struct KeyHash
+	{
+		std::size_t operator()(const Key& key) const
+		{
+			return std::hash<FDL::Uint64>()((static_cast<FDL::Uint64>(key.inode) * 0x9E3779B97F4A7C15ULL)
+				^ static_cast<FDL::Uint64>(key.device));
+		}
+	};
+
+	struct Shard
+	{
+		std::mutex mutex;
+		std::unordered_set<Key, KeyHash> keys;
+	};
+
+	static const std::size_t SHARD_COUNT = 64;
+	Shard m_shards[SHARD_COUNT];
+public:
+
+	//	Whether the pair was not already in the set
+	bool insert(dev_t device, ino_t inode)
+	{
+		Key key = { device, inode };
+		Shard& shard = m_shards[(KeyHash()(key) >> 16) % SHARD_COUNT];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		return shard.keys.insert(key).second;
+	}
+};
+
+//	Totals gathered by a single worker for a single directory
+struct _DiskUsageTally
+{
+	FDL::Uint64 apparentBytes;
+	FDL::Uint64 allocatedBytes;
+	FDL::Uint64 fileCount;
+	FDL::Uint64 directoryCount;
+	FDL::Uint64 skippedCount;
+
+	_DiskUsageTally() : apparentBytes(0), allocatedBytes(0), fileCount(0), directoryCount(0), skippedCount(0) {}
+
+	void add(const _DiskUsageTally& tally)
+	{
+		apparentBytes += tally.apparentBytes;
+		allocatedBytes += tally.allocatedBytes;
+		fileCount += tally.fileCount;
+		directoryCount += tally.directoryCount;
+		skippedCount += tally.skippedCount;
+	}
+};
+
+//	Totals shared between every worker of a scan
+struct _DiskUsageCounters
+{
+	std::atomic<FDL::Uint64> apparentBytes;
+	std::atomic<FDL::Uint64> allocatedBytes;
+	std::atomic<FDL::Uint64> fileCount;
+	std::atomic<FDL::Uint64> directoryCount;
+	std::atomic<FDL::Uint64> skippedCount;
+
+	_DiskUsageCounters() : apparentBytes(0), allocatedBytes(0), fileCount(0), directoryCount(0), skippedCount(0) {}
+
+	void add(const _DiskUsageTally& tally)
+	{
+		apparentBytes += tally.apparentBytes;
+		allocatedBytes += tally.allocatedBytes;
+		fileCount += tally.fileCount;
+		directoryCount += tally.directoryCount;
+		skippedCount += tally.skippedCount;
+	}
+
+	void store(FDL::DiskUsage& usage) const
+	{
+		usage.apparentBytes = apparentBytes;
+		usage.allocatedBytes = allocatedBytes;
+		usage.fileCount = fileCount;
+		usage.directoryCount = directoryCount;
+		usage.skippedCount = skippedCount;
+	}
+};
+
+//	Subdirectories whose open descriptors may wait in the queue at once,
+//	any more are scanned in place so open descriptors stay bounded
+static const int MAX_QUEUED_DIRECTORIES = 256;
+
+//	State of one Directory::diskUsage call, rollups are only appended to by
+//	the task scanning the root so their addresses stay valid for the others
+struct _DiskUsageScan
+{
+	bool deduplicate;
+	_InodeSet inodes;
+	_DiskUsageCounters total;
+	std::deque<_DiskUsageCounters> rollups;
+	std::vector<FDL::String> rollupPaths;
+	FDL::Arena* p_arena;
+	std::atomic<int> queuedDirectories;
+	_TaskPool pool;
+
+	_DiskUsageScan(const FDL::DiskUsageOptions& options, FDL::Arena* p_arena)
+		: deduplicate(options.deduplicateHardLinks), p_arena(p_arena), queuedDirectories(0), pool(options.threadCount) {}
+};
+
+//	Adds one entry to tally unless it is a hard link already counted
+static void _diskUsageEntry(_DiskUsageScan& scan, const struct stat& status, _DiskUsageTally& tally)
+{
+	if(S_ISDIR(status.st_mode)) ++tally.directoryCount;
+	else
+	{
+		if(scan.deduplicate && status.st_nlink > 1 && !scan.inodes.insert(status.st_dev, status.st_ino)) return;
+		++tally.fileCount;
+	}
+	tally.apparentBytes += status.st_size;
+	tally.allocatedBytes += static_cast<FDL::Uint64>(status.st_blocks) * 512;
+}
+
+//	Stats the entries of an open directory and scans its subdirectories,
+//	which are opened relative to it so no path length limit applies. Takes
+//	ownership of directoryFd. Children are rolled up under rollupRoot when
+//	it is given
+static void _diskUsageDirectory(_DiskUsageScan& scan, int directoryFd, _DiskUsageCounters* p_rollup,
+	const char* rollupRoot)
+{
+	_DiskUsageTally tally;
+	DIR* p_directory = fdopendir(directoryFd);
+	if(p_directory == NULL)
+	{
+		close(directoryFd);
+		++tally.skippedCount;
+		scan.total.add(tally);
+		if(p_rollup != NULL) p_rollup->add(tally);
+		return;
+	}
+
+	struct stat status;
+	for(;;)
+	{
+		errno = 0;
+		struct dirent* p_entry = readdir(p_directory);
+		if(p_entry == NULL)
+		{
+			if(errno != 0) ++tally.skippedCount;
+			break;
+		}
+		if(_isDotEntry(p_entry->d_name)) continue;
+		if(fstatat(directoryFd, p_entry->d_name, &status, AT_SYMLINK_NOFOLLOW) != 0)
+		{
+			++tally.skippedCount;
+			continue;
+		}
+
+		_DiskUsageTally entry;
+		_diskUsageEntry(scan, status, entry);
+		tally.add(entry);
+		if(!S_ISDIR(status.st_mode)) continue;
+
+		_DiskUsageCounters* p_childRollup = p_rollup;
+		if(rollupRoot != NULL)
+		{
+			scan.rollups.emplace_back();
+			//	Only this task touches the Arena of the caller
+			if(scan.p_arena != NULL)
+			{
+				const char* p_path = _joinPath(*scan.p_arena, rollupRoot, p_entry->d_name);
+				scan.rollupPaths.push_back(FDL::String::borrow(p_path, std::strlen(p_path)));
+			}
+			else
+			{
+				std::string path = _joinPath(rollupRoot, p_entry->d_name);
+				scan.rollupPaths.push_back(FDL::String(path.c_str(), path.size()));
+			}
+			p_childRollup = &scan.rollups.back();
+			p_childRollup->add(entry);
+		}
+
+		int childFd = openat(directoryFd, p_entry->d_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+		if(childFd < 0)
+		{
+			++tally.skippedCount;
+			if(p_childRollup != p_rollup) ++p_childRollup->skippedCount;
+			continue;
+		}
+		if(scan.queuedDirectories.fetch_add(1) < MAX_QUEUED_DIRECTORIES)
+		{
+			_DiskUsageScan* p_scan = &scan;
+			scan.pool.submit([p_scan, childFd, p_childRollup]
+			{
+				--p_scan->queuedDirectories;
+				_diskUsageDirectory(*p_scan, childFd, p_childRollup, NULL);
+			});
+		}
+		else
+		{
+			--scan.queuedDirectories;
+			_diskUsageDirectory(scan, childFd, p_childRollup, NULL);
+		}
+	}
+	closedir(p_directory);
+
+	scan.total.add(tally);
+	if(p_rollup != NULL) p_rollup->add(tally);
+}
+
+bool _diskUsage_Platform(const char* path, const FDL::DiskUsageOptions& options, FDL::Arena* p_arena,
+	FDL::DiskUsage& usage)
+{
+	int rootFd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if(rootFd < 0) return false;
+	struct stat status;
+	if(fstat(rootFd, &status) != 0)
+	{
+		close(rootFd);
+		return false;
+	}
+
+	_DiskUsageScan scan(options, p_arena);
+	_DiskUsageTally root;
+	_diskUsageEntry(scan, status, root);
+	scan.total.add(root);
+
+	const char* rollupRoot = options.subdirectoryRollups ? path : NULL;
+	_DiskUsageScan* p_scan = &scan;
+	scan.pool.submit([p_scan, rootFd, rollupRoot]
+	{
+		_diskUsageDirectory(*p_scan, rootFd, NULL, rollupRoot);
+	});
+	scan.pool.wait();
+
+	usage.path = p_arena != NULL ? p_arena->copyString(path, std::strlen(path)) : FDL::String(path);
+	scan.total.store(usage);
+	if(!scan.rollups.empty())
+	{
+		std::vector<FDL::DiskUsage> subdirectories(scan.rollups.size());
+		for(std::size_t i = 0; i < subdirectories.size(); ++i)
+		{
+			subdirectories[i].path = std::move(scan.rollupPaths[i]);
+			scan.rollups[i].store(subdirectories[i]);
+		}
+		usage.subdirectories = FDL::ImmutableList<FDL::DiskUsage>(&subdirectories[0], subdirectories.size(), p_arena);
+	}
+	return true;
+}
+
+///////////////////////////////////////
+//	Tree Copying
+///////////////////////////////////////
+
+//	A file or link found while creating the destination directories, the
+//	paths are held by the Arena of the copy
+struct _CopyEntry
+{
+	const char* source;
+	const char* destination;
+	struct stat status;
+};
+
+//	Whether both times are the same
+static bool _sameTime(const struct timespec& lhs, const struct timespec& rhs)
+{
+	return lhs.tv_sec == rhs.tv_sec && lhs.tv_nsec == rhs.tv_nsec;
+}
+
+//	Writes all of size bytes from data to fd
+static bool _writeAll(int fd, const char* data, std::size_t size)
+{
+	while(size > 0)
+	{
+		ssize_t written = write(fd, data, size);
+		if(written < 0)
+		{
+			if(errno == EINTR) continue;
+			return false;
+		}
+		data += written;
+		size -= static_cast<std::size_t>(written);
+	}
+	return true;
+}
+
+//	Copies the contents of inFd into the empty outFd, trying a reflink clone,
+//	then an in-kernel copy, then a buffered copy
+static bool _copyContents(int inFd, int outFd, FDL::Uint64 size)
+{
+#ifdef FICLONE
+	if(ioctl(outFd, FICLONE, inFd) == 0) return true;
+#endif
+
+	FDL::Uint64 done = 0;
+#ifdef __linux__
+	while(done < size)
+	{
+		ssize_t copied = copy_file_range(inFd, NULL, outFd, NULL, static_cast<std::size_t>(size - done), 0);
+		if(copied < 0)
+		{
+			if(errno == EINTR) continue;
+			if(done == 0 && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP)) break;
+			return false;
+		}
+		if(copied == 0) return true;
+		done += static_cast<FDL::Uint64>(copied);
+	}
+	if(done > 0) return true;
+#endif
+
+	char buffer[128 * 1024];
+	for(;;)
+	{
+		ssize_t readSize = read(inFd, buffer, sizeof(buffer));
+		if(readSize < 0)
+		{
+			if(errno == EINTR) continue;
+			return false;
+		}
+		if(readSize == 0) return true;
+		if(!_writeAll(outFd, buffer, static_cast<std::size_t>(readSize))) return false;
+	}
+}
+
+//	Whether the destination of entry is of the same type, size and
+//	modification time as its source
+static bool _isUnchanged(const _CopyEntry& entry)
+{
+	struct stat current;
+	return lstat(entry.destination, &current) == 0 && (current.st_mode & S_IFMT) == (entry.status.st_mode & S_IFMT)
+		&& current.st_size == entry.status.st_size && _sameTime(current.st_mtim, entry.status.st_mtim);
+}
+
+//	Copies one regular file, false on failure, skipped marks unchanged files
+static bool _copyFile(const _CopyEntry& entry, const FDL::CopyOptions& options, bool& skipped)
+{
+	skipped = options.skipUnchanged && _isUnchanged(entry);
+	if(skipped) return true;
+
+	int inFd = open(entry.source, O_RDONLY | O_CLOEXEC);
+	if(inFd < 0) return false;
+
+	//	A link already at the destination is replaced, never written through.
+	//	So is a file an earlier copy made read-only by preserving its mode
+	mode_t mode = (entry.status.st_mode & 0777) | S_IWUSR;
+	int outFd = open(entry.destination, O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC, mode);
+	if(outFd < 0 && (errno == ELOOP || errno == EACCES) && unlink(entry.destination) == 0)
+		outFd = open(entry.destination, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, mode);
+	if(outFd < 0)
+	{
+		close(inFd);
+		return false;
+	}
+
+	bool success = _copyContents(inFd, outFd, static_cast<FDL::Uint64>(entry.status.st_size));
+	if(success && options.preserveMode) success = fchmod(outFd, entry.status.st_mode & 07777) == 0;
+	if(success && options.preserveTimes)
+	{
+		struct timespec times[2] = { entry.status.st_atim, entry.status.st_mtim };
+		success = futimens(outFd, times) == 0;
+	}
+	close(inFd);
+	if(close(outFd) != 0) success = false;
+	return success;
+}
+
+//	Recreates a symbolic link, replacing whatever is at the destination,
+//	skipped marks unchanged links
+static bool _copyLink(const _CopyEntry& entry, const FDL::CopyOptions& options, bool& skipped)
+{
+	skipped = options.skipUnchanged && _isUnchanged(entry);
+	if(skipped) return true;
+
+	std::vector<char> target(static_cast<std::size_t>(entry.status.st_size) + 1);
+	ssize_t length = readlink(entry.source, &target[0], target.size());
+	if(length < 0 || static_cast<std::size_t>(length) >= target.size()) return false;
+	target[static_cast<std::size_t>(length)] = '\0';
+	unlink(entry.destination);
+	if(symlink(&target[0], entry.destination) != 0) return false;
+	if(!options.preserveTimes) return true;
+	struct timespec times[2] = { entry.status.st_atim, entry.status.st_mtim };
+	return utimensat(AT_FDCWD, entry.destination, times, AT_SYMLINK_NOFOLLOW) == 0;
+}
+
+//	Whether path, or the nearest existing directory above it, is the
+//	directory identified by status or lies below it
+static bool _isInside(std::string path, const struct stat& directory)
+{
+	struct stat status;
+	while(stat(path.c_str(), &status) != 0)
+	{
+		if(path == "." || path == "/") return false;
+		std::size_t slash = path.find_last_of('/');
+		if(slash == std::string::npos) path = ".";
+		else if(slash == 0) path = "/";
+		else path.erase(slash);
+	}
+	for(;;)
+	{
+		if(status.st_dev == directory.st_dev && status.st_ino == directory.st_ino) return true;
+		path += "/..";
+		struct stat parent;
+		if(stat(path.c_str(), &parent) != 0) return false;
+		if(parent.st_dev == status.st_dev && parent.st_ino == status.st_ino) return false;
+		status = parent;
+	}
+}
+
+bool _copyTree_Platform(const char* source, const char* destination, const FDL::CopyOptions& options,
+	FDL::Uint64& copied, FDL::Uint64& failed)
+{
+	struct stat status;
+	if(stat(source, &status) != 0 || !S_ISDIR(status.st_mode)) return false;
+
+	//	Otherwise the walk would find every directory it creates and nest
+	//	copies until the path is too long
+	if(_isInside(destination, status))
+		throw FDL::BadPathException("Destination is inside the source directory");
+
+	//	Directories are created breadth first on this thread so that every
+	//	file task finds its parent already in place. Every path is kept until
+	//	the end, in one Arena rather than two allocations per entry
+	FDL::Arena arena;
+	std::vector<_CopyEntry> directories(1);
+	directories[0].source = source;
+	directories[0].destination = destination;
+	directories[0].status = status;
+	std::vector<_CopyEntry> files;
+	FDL::Uint64 failures = 0;
+
+	for(std::size_t i = 0; i < directories.size(); ++i)
+	{
+		//	The owner keeps write access until the contents are copied
+		mode_t mode = (directories[i].status.st_mode & 0777) | S_IRWXU;
+		if(mkdir(directories[i].destination, mode) != 0)
+		{
+			//	An existing link is not followed out of the destination. An
+			//	existing directory that an earlier copy made read-only gets
+			//	write access back until its mode is restored at the end
+			struct stat existing;
+			if(errno != EEXIST || lstat(directories[i].destination, &existing) != 0
+				|| !S_ISDIR(existing.st_mode)
+				|| ((existing.st_mode & S_IRWXU) != S_IRWXU && chmod(directories[i].destination, existing.st_mode | S_IRWXU) != 0))
+			{
+				++failures;
+				continue;
+			}
+		}
+		DIR* p_directory = opendir(directories[i].source);
+		if(p_directory == NULL)
+		{
+			++failures;
+			continue;
+		}
+		int directoryFd = dirfd(p_directory);
+		struct dirent* p_entry;
+		while((p_entry = readdir(p_directory)) != NULL)
+		{
+			if(_isDotEntry(p_entry->d_name)) continue;
+			_CopyEntry entry;
+			if(fstatat(directoryFd, p_entry->d_name, &entry.status, AT_SYMLINK_NOFOLLOW) != 0)
+			{
+				++failures;
+				continue;
+			}
+			if(!S_ISDIR(entry.status.st_mode) && !S_ISREG(entry.status.st_mode)
+				&& !S_ISLNK(entry.status.st_mode)) continue;
+			entry.source = _joinPath(arena, directories[i].source, p_entry->d_name);
+			entry.destination = _joinPath(arena, directories[i].destination, p_entry->d_name);
+			if(S_ISDIR(entry.status.st_mode)) directories.push_back(entry);
+			else files.push_back(entry);
+		}
+		closedir(p_directory);
+	}
+
+	std::atomic<FDL::Uint64> copiedFiles(0);
+	std::atomic<FDL::Uint64> failedFiles(0);
+	{
+		_TaskPool pool(options.threadCount);
+		for(std::size_t i = 0; i < files.size(); ++i)
+		{
+			const _CopyEntry* p_entry = &files[i];
+			const FDL::CopyOptions* p_options = &options;
+			std::atomic<FDL::Uint64>* p_copied = &copiedFiles;
+			std::atomic<FDL::Uint64>* p_failed = &failedFiles;
+			pool.submit([p_entry, p_options, p_copied, p_failed]
+			{
+				bool skipped = false;
+				bool success = S_ISLNK(p_entry->status.st_mode) ? _copyLink(*p_entry, *p_options, skipped)
+					: _copyFile(*p_entry, *p_options, skipped);
+				if(!success) ++*p_failed;
+				else if(!skipped) ++*p_copied;
+			});
+		}
+		pool.wait();
+	}
+
+	//	Directory attributes go last, deepest first, as creating their
+	//	contents would otherwise change the times again
+	for(std::size_t i = directories.size(); i-- > 0;)
+	{
+		const _CopyEntry& entry = directories[i];
+		if(options.preserveMode && chmod(entry.destination, entry.status.st_mode & 07777) != 0)
+			++failures;
+		if(options.preserveTimes)
+		{
+			struct timespec times[2] = { entry.status.st_atim, entry.status.st_mtim };
+			if(utimensat(AT_FDCWD, entry.destination, times, 0) != 0) ++failures;
+		}
+	}
+
+	copied = copiedFiles;
+	failed = failedFiles + failures;
+	return true;
+}
+
+///////////////////////////////////////
+//	Tree Comparison
+///////////////////////////////////////
+
+//	One entry of a directory listing, the name is held by the Arena of the
+//	listing
+struct _DiffListing
+{
+	const char* name;
+	std::size_t nameSize;
+	struct stat status;
+
+	bool operator<(const _DiffListing& rhs) const
+	{
+		return std::strcmp(name, rhs.name) < 0;
+	}
+};
+
+//	State of one Directory::diff or Directory::diffSnapshot call, a failed
+//	scan stops reporting and queues no further directories
+struct _DiffScan
+{
+	std::string root;
+	std::string otherRoot;
+	const FDL::DiffOptions& options;
+	const std::function<void(const FDL::DiffEntry&)>& callback;
+	std::mutex callbackMutex;
+	std::atomic<bool> failed;
+	_TaskPool* p_pool;
+	FDL::Arena* p_arena;
+
+	_DiffScan(const char* path, const char* otherPath, const FDL::DiffOptions& options,
+		const std::function<void(const FDL::DiffEntry&)>& callback, FDL::Arena* p_arena)
+		: root(path), otherRoot(otherPath), options(options), callback(callback), failed(false), p_pool(NULL),
+		p_arena(p_arena) {}
+
+	//	The path goes into the Arena of the caller under the lock, the only
+	//	place it is touched
+	void report(FDL::DiffEntry::Change change, const std::string& relativePath, bool directory)
+	{
+		FDL::DiffEntry entry;
+		entry.change = change;
+		entry.directory = directory;
+		std::lock_guard<std::mutex> lock(callbackMutex);
+		if(failed) return;
+		entry.path = p_arena != NULL ? p_arena->copyString(relativePath.c_str(), relativePath.size())
+			: FDL::String(relativePath.c_str(), relativePath.size());
+		callback(entry);
+	}
+};
+
+//	Reads and sorts the entries of a directory into arena, an entry removed
+//	while listing is left out. A directory removed or replaced since its
+//	parent was listed lists as empty, so its entries are reported removed
+//	instead of failing the scan
+static void _listDirectory(const std::string& path, std::vector<_DiffListing>& entries, FDL::Arena& arena)
+{
+	DIR* p_directory = opendir(path.c_str());
+	if(p_directory == NULL)
+	{
+		if(errno == ENOENT || errno == ENOTDIR) return;
+		throw FDL::File::FileFailException(("Directory could not be listed: " + path).c_str());
+	}
+	int directoryFd = dirfd(p_directory);
+	struct dirent* p_entry;
+	while((p_entry = readdir(p_directory)) != NULL)
+	{
+		if(_isDotEntry(p_entry->d_name)) continue;
+		_DiffListing entry;
+		if(fstatat(directoryFd, p_entry->d_name, &entry.status, AT_SYMLINK_NOFOLLOW) != 0)
+		{
+			if(errno == ENOENT) continue;
+			closedir(p_directory);
+			throw FDL::File::FileFailException(("Entry could not be examined: " + _joinPath(path, p_entry->d_name)).c_str());
+		}
+		entry.nameSize = std::strlen(p_entry->d_name);
+		entry.name = arena.copyString(p_entry->d_name, entry.nameSize).c_str();
+		entries.push_back(entry);
+	}
+	closedir(p_directory);
+	std::sort(entries.begin(), entries.end());
+}
+
+//	Reads until buffer is full or the file ends
+static ssize_t _readFull(int fd, char* buffer, std::size_t size)
+{
+	std::size_t done = 0;
+	while(done < size)
+	{
+		ssize_t readSize = read(fd, buffer + done, size - done);
+		if(readSize < 0)
+		{
+			if(errno == EINTR) continue;
+			return -1;
+		}
+		if(readSize == 0) break;
+		done += static_cast<std::size_t>(readSize);
+	}
+	return static_cast<ssize_t>(done);
+}
+
+//	Compares two files or links of equal size chunk by chunk, stopping at
+//	the first difference, throws if either can not be read
+static bool _sameContents(const std::string& path, const std::string& otherPath, const struct stat& status)
+{
+	if(S_ISLNK(status.st_mode))
+	{
+		std::vector<char> target(static_cast<std::size_t>(status.st_size) + 1);
+		std::vector<char> otherTarget(target.size());
+		ssize_t length = readlink(path.c_str(), &target[0], target.size());
+		ssize_t otherLength = readlink(otherPath.c_str(), &otherTarget[0], otherTarget.size());
+		if(length < 0 || otherLength < 0) throw FDL::File::FileFailException(("Link could not be read: " + path).c_str());
+		return length == otherLength && std::memcmp(&target[0], &otherTarget[0], static_cast<std::size_t>(length)) == 0;
+	}
+	if(!S_ISREG(status.st_mode)) return true;
+
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if(fd < 0) throw FDL::File::FileFailException(("File could not be read: " + path).c_str());
+	int otherFd = open(otherPath.c_str(), O_RDONLY | O_CLOEXEC);
+	if(otherFd < 0)
+	{
+		close(fd);
+		throw FDL::File::FileFailException(("File could not be read: " + otherPath).c_str());
+	}
+
+	std::vector<char> buffer(64 * 1024);
+	std::vector<char> otherBuffer(buffer.size());
+	bool same = true;
+	bool failed = false;
+	for(;;)
+	{
+		ssize_t readSize = _readFull(fd, &buffer[0], buffer.size());
+		ssize_t otherReadSize = _readFull(otherFd, &otherBuffer[0], otherBuffer.size());
+		if(readSize < 0 || otherReadSize < 0)
+		{
+			failed = true;
+			break;
+		}
+		if(readSize != otherReadSize || std::memcmp(&buffer[0], &otherBuffer[0], static_cast<std::size_t>(readSize)) != 0)
+		{
+			same = false;
+			break;
+		}
+		if(readSize == 0) break;
+	}
+	close(fd);
+	close(otherFd);
+	if(failed) throw FDL::File::FileFailException(("File could not be read: " + path).c_str());
+	return same;
+}
+
+//	Whether a non-directory entry present on both sides changed
+static bool _isModified(_DiffScan& scan, const std::string& relativePath, const struct stat& status,
+	const struct stat& otherStatus)
+{
+	if((status.st_mode & S_IFMT) != (otherStatus.st_mode & S_IFMT) || status.st_size != otherStatus.st_size)
+		return true;
+	bool sameMetadata = _sameTime(status.st_mtim, otherStatus.st_mtim)
+		&& (!scan.options.compareInodes || status.st_ino == otherStatus.st_ino);
+	if(sameMetadata) return false;
+	if(!scan.options.compareContents) return true;
+	return !_sameContents(_joinPath(scan.root, relativePath.c_str()),
+		_joinPath(scan.otherRoot, relativePath.c_str()), status);
+}
+
+//	Merges the sorted listings of one directory pair, handing each
+//	subdirectory present on both sides to descend and each one only present
+//	in entries to dropTree
+static void _mergeListings(_DiffScan& scan, const std::string& relativePath, const std::vector<_DiffListing>& entries,
+	const std::vector<_DiffListing>& otherEntries, const std::function<void(const std::string&)>& descend,
+	const std::function<void(const std::string&)>& dropTree)
+{
+	std::size_t i = 0;
+	std::size_t j = 0;
+	std::string childPath;
+	while((i < entries.size() || j < otherEntries.size()) && !scan.failed)
+	{
+		int order = i == entries.size() ? 1 : j == otherEntries.size() ? -1
+			: std::strcmp(entries[i].name, otherEntries[j].name);
+		const _DiffListing& entry = order <= 0 ? entries[i] : otherEntries[j];
+
+		//	Reused for every entry, the common unchanged file allocates nothing
+		childPath.assign(relativePath);
+		if(!childPath.empty()) childPath += '/';
+		childPath.append(entry.name, entry.nameSize);
+		if(order < 0)
+		{
+			scan.report(FDL::DiffEntry::REMOVED, childPath, S_ISDIR(entry.status.st_mode));
+			if(S_ISDIR(entry.status.st_mode)) dropTree(childPath);
+			++i;
+			continue;
+		}
+		if(order > 0)
+		{
+			scan.report(FDL::DiffEntry::ADDED, childPath, S_ISDIR(entry.status.st_mode));
+			++j;
+			continue;
+		}
+
+		const struct stat& status = entries[i].status;
+		const struct stat& otherStatus = otherEntries[j].status;
+		if(S_ISDIR(status.st_mode) != S_ISDIR(otherStatus.st_mode))
+		{
+			scan.report(FDL::DiffEntry::REMOVED, childPath, S_ISDIR(status.st_mode));
+			scan.report(FDL::DiffEntry::ADDED, childPath, S_ISDIR(otherStatus.st_mode));
+			if(S_ISDIR(status.st_mode)) dropTree(childPath);
+		}
+		else if(S_ISDIR(status.st_mode)) descend(childPath);
+		else if(_isModified(scan, childPath, status, otherStatus))
+			scan.report(FDL::DiffEntry::MODIFIED, childPath, false);
+		++i;
+		++j;
+	}
+}
+
+static void _diffDirectory(_DiffScan& scan, const std::string& relativePath);
+
+//	Queues a directory pair on the pool, the first failure stops the scan
+//	and is rethrown by the pool
+static void _submitDiff(_DiffScan& scan, const std::string& relativePath)
+{
+	_DiffScan* p_scan = &scan;
+	scan.p_pool->submit([p_scan, relativePath]
+	{
+		if(p_scan->failed) return;
+		try
+		{
+			_diffDirectory(*p_scan, relativePath);
+		}
+		catch(...)
+		{
+			p_scan->failed = true;
+			throw;
+		}
+	});
+}
+
+//	Compares one directory pair, queueing the subdirectories present on
+//	both sides
+static void _diffDirectory(_DiffScan& scan, const std::string& relativePath)
+{
+	FDL::Arena arena(16 * 1024);
+	std::vector<_DiffListing> entries;
+	std::vector<_DiffListing> otherEntries;
+	_listDirectory(relativePath.empty() ? scan.root : _joinPath(scan.root, relativePath.c_str()), entries, arena);
+	_listDirectory(relativePath.empty() ? scan.otherRoot : _joinPath(scan.otherRoot, relativePath.c_str()), otherEntries,
+		arena);
+
+	_DiffScan* p_scan = &scan;
+	_mergeListings(scan, relativePath, entries, otherEntries,
+		[p_scan](const std::string& childPath) { _submitDiff(*p_scan, childPath); },
+		[](const std::string&) {});
+}
+
+bool _diffTree_Platform(const char* path, const char* otherPath, const FDL::DiffOptions& options,
+	const std::function<void(const FDL::DiffEntry&)>& callback, FDL::Arena* p_arena)
+{
+	struct stat status;
+	if(stat(path, &status) != 0 || !S_ISDIR(status.st_mode)) return false;
+	if(stat(otherPath, &status) != 0 || !S_ISDIR(status.st_mode)) return false;
+
+	_TaskPool pool(options.threadCount);
+	_DiffScan scan(path, otherPath, options, callback, p_arena);
+	scan.p_pool = &pool;
+	_submitDiff(scan, std::string());
+	pool.wait();
+	return true;
+}
+
+///////////////////////////////////////
+//	Tree Snapshots
+///////////////////////////////////////
+
+//	A snapshot holds the magic, then one block per directory in the order
+//	_writeSnapshotDirectory visits them: the relative path and entry count,
+//	followed by the name-sorted entries. Values are in native byte order
+static const char SNAPSHOT_MAGIC[8] = { 'F', 'D', 'L', 'S', 'N', 'A', 'P', '1' };
+
+//	The part of an entry kept in a snapshot
+struct _SnapshotStatus
+{
+	FDL::Uint32 mode;
+	FDL::Uint64 size;
+	FDL::Int64 modifiedSeconds;
+	FDL::Int64 modifiedNanoseconds;
+	FDL::Uint64 inode;
+};
+
+static void _writeSnapshotValue(std::FILE* p_file, const void* p_value, std::size_t size)
+{
+	if(std::fwrite(p_value, 1, size, p_file) != size) throw FDL::File::FileFailException("Snapshot could not be written");
+}
+
+static void _writeSnapshotString(std::FILE* p_file, const char* value, std::size_t size)
+{
+	FDL::Uint32 storedSize = static_cast<FDL::Uint32>(size);
+	_writeSnapshotValue(p_file, &storedSize, sizeof(storedSize));
+	_writeSnapshotValue(p_file, value, size);
+}
+
+//	Writes the block of a directory, then those of its subdirectories in
+//	name order, so a reader can follow along with a depth-first walk
+static void _writeSnapshotDirectory(std::FILE* p_file, const std::string& root, const std::string& relativePath)
+{
+	FDL::Arena arena(16 * 1024);
+	std::vector<_DiffListing> entries;
+	_listDirectory(relativePath.empty() ? root : _joinPath(root, relativePath.c_str()), entries, arena);
+
+	_writeSnapshotString(p_file, relativePath.c_str(), relativePath.size());
+	FDL::Uint64 count = entries.size();
+	_writeSnapshotValue(p_file, &count, sizeof(count));
+	for(std::size_t i = 0; i < entries.size(); ++i)
+	{
+		_SnapshotStatus status;
+		std::memset(&status, 0, sizeof(status));
+		status.mode = static_cast<FDL::Uint32>(entries[i].status.st_mode);
+		status.size = static_cast<FDL::Uint64>(entries[i].status.st_size);
+		status.modifiedSeconds = static_cast<FDL::Int64>(entries[i].status.st_mtim.tv_sec);
+		status.modifiedNanoseconds = static_cast<FDL::Int64>(entries[i].status.st_mtim.tv_nsec);
+		status.inode = static_cast<FDL::Uint64>(entries[i].status.st_ino);
+		_writeSnapshotString(p_file, entries[i].name, entries[i].nameSize);
+		_writeSnapshotValue(p_file, &status, sizeof(status));
+	}
+
+	for(std::size_t i = 0; i < entries.size(); ++i)
+	{
+		if(S_ISDIR(entries[i].status.st_mode))
+			_writeSnapshotDirectory(p_file, root, relativePath.empty() ? std::string(entries[i].name)
+				: _joinPath(relativePath, entries[i].name));
+	}
+}
+
+//	Streams the blocks of a snapshot, always holding the header of the next
+class _SnapshotReader
+{
+private:
+
+	std::FILE* mp_file;
+	bool m_hasBlock;
+	std::string m_blockPath;
+	FDL::Uint64 m_blockSize;
+
+	void _readValue(void* p_value, std::size_t size)
+	{
+		if(std::fread(p_value, 1, size, mp_file) != size) throw FDL::File::FileFailException("Snapshot is damaged");
+	}
+
+	void _readString(std::string& value)
+	{
+		FDL::Uint32 size = 0;
+		_readValue(&size, sizeof(size));
+		value.resize(size);
+		if(size > 0) _readValue(&value[0], size);
+	}
+
+	const char* _readString(FDL::Arena& arena, std::size_t& size)
+	{
+		FDL::Uint32 storedSize = 0;
+		_readValue(&storedSize, sizeof(storedSize));
+		size = storedSize;
+		char* p_value = static_cast<char*>(arena.allocate(size + 1, 1));
+		_readValue(p_value, size);
+		p_value[size] = '\0';
+		return p_value;
+	}
+
+	void _readHeader()
+	{
+		int next = std::fgetc(mp_file);
+		m_hasBlock = next != EOF;
+		if(!m_hasBlock) return;
+		std::ungetc(next, mp_file);
+		_readString(m_blockPath);
+		_readValue(&m_blockSize, sizeof(m_blockSize));
+	}
+
+	static bool _isWithin(const std::string& path, const std::string& directory)
+	{
+		return path.size() > directory.size() && path.compare(0, directory.size(), directory) == 0
+			&& path[directory.size()] == '/';
+	}
+public:
+
+	//	Throws if path is not a snapshot
+	explicit _SnapshotReader(std::FILE* p_file) : mp_file(p_file), m_hasBlock(false), m_blockSize(0)
+	{
+		char magic[sizeof(SNAPSHOT_MAGIC)];
+		if(std::fread(magic, 1, sizeof(magic), mp_file) != sizeof(magic)
+			|| std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0)
+			throw FDL::File::FileFailException("File is not a snapshot");
+		_readHeader();
+	}
+
+	//	Reads the block of relativePath, which must come next, with the names
+	//	going into arena
+	void readBlock(const std::string& relativePath, std::vector<_DiffListing>& entries, FDL::Arena& arena)
+	{
+		if(!m_hasBlock || m_blockPath != relativePath) throw FDL::File::FileFailException("Snapshot is damaged");
+		entries.resize(static_cast<std::size_t>(m_blockSize));
+		for(std::size_t i = 0; i < entries.size(); ++i)
+		{
+			_SnapshotStatus status;
+			entries[i].name = _readString(arena, entries[i].nameSize);
+			_readValue(&status, sizeof(status));
+			std::memset(&entries[i].status, 0, sizeof(entries[i].status));
+			entries[i].status.st_mode = static_cast<mode_t>(status.mode);
+			entries[i].status.st_size = static_cast<off_t>(status.size);
+			entries[i].status.st_mtim.tv_sec = static_cast<time_t>(status.modifiedSeconds);
+			entries[i].status.st_mtim.tv_nsec = static_cast<long>(status.modifiedNanoseconds);
+			entries[i].status.st_ino = static_cast<ino_t>(status.inode);
+		}
+		_readHeader();
+	}
+
+	//	Passes over the blocks of relativePath and everything below it
+	void skipTree(const std::string& relativePath)
+	{
+		FDL::Arena arena(16 * 1024);
+		std::vector<_DiffListing> entries;
+		while(m_hasBlock && (m_blockPath == relativePath || _isWithin(m_blockPath, relativePath)))
+		{
+			readBlock(m_blockPath, entries, arena);
+			arena.release();
+		}
+	}
+};
+
+//	Compares the snapshot block of a directory against its listing, then
+//	descends in the order the snapshot was written
+static void _diffSnapshotDirectory(_DiffScan& scan, _SnapshotReader& reader, const std::string& relativePath)
+{
+	FDL::Arena arena(16 * 1024);
+	std::vector<_DiffListing> entries;
+	std::vector<_DiffListing> otherEntries;
+	reader.readBlock(relativePath, entries, arena);
+	_listDirectory(relativePath.empty() ? scan.otherRoot : _joinPath(scan.otherRoot, relativePath.c_str()), otherEntries,
+		arena);
+
+	_DiffScan* p_scan = &scan;
+	_SnapshotReader* p_reader = &reader;
+	_mergeListings(scan, relativePath, entries, otherEntries,
+		[p_scan, p_reader](const std::string& childPath) { _diffSnapshotDirectory(*p_scan, *p_reader, childPath); },
+		[p_reader](const std::string& childPath) { p_reader->skipTree(childPath); });
+}
+
+bool _writeSnapshot_Platform(const char* path, const char* snapshotPath)
+{
+	struct stat status;
+	if(stat(path, &status) != 0 || !S_ISDIR(status.st_mode)) return false;
+
+	std::FILE* p_file = std::fopen(snapshotPath, "wb");
+	if(p_file == NULL) throw FDL::File::FileFailException("Snapshot could not be created");
+	try
+	{
+		_writeSnapshotValue(p_file, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+		_writeSnapshotDirectory(p_file, path, std::string());
+	}
+	catch(...)
+	{
+		std::fclose(p_file);
+		throw;
+	}
+	if(std::fclose(p_file) != 0) throw FDL::File::FileFailException("Snapshot could not be written");
+	return true;
+}
+
+bool _diffSnapshot_Platform(const char* snapshotPath, const char* path, const FDL::DiffOptions& options,
+	const std::function<void(const FDL::DiffEntry&)>& callback, FDL::Arena* p_arena)
+{
+	struct stat status;
+	if(stat(path, &status) != 0 || !S_ISDIR(status.st_mode)) return false;
+	std::FILE* p_file = std::fopen(snapshotPath, "rb");
+	if(p_file == NULL) return false;
+
+	//	A snapshot holds no contents to compare
+	FDL::DiffOptions snapshotOptions(options);
+	snapshotOptions.compareContents = false;
+	_DiffScan scan(snapshotPath, path, snapshotOptions, callback, p_arena);
+	try
+	{
+		_SnapshotReader reader(p_file);
+		_diffSnapshotDirectory(scan, reader, std::string());
+	}
+	catch(...)
+	{
+		std::fclose(p_file);
+		throw;
+	}
+	std::fclose(p_file);
+	return true;
+}
+
+// TODO: Create POSIX handling
+
+#endif /* _FDL_POSIX */
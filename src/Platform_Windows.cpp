@@ -0,0 +1,150 @@
+#include "Platform.hpp"
+
+#ifdef _FDL_WINDOWS
+
+#include <windows.h>
+
+bool _createFile_Platform(const char* path, bool recursive)
+{
+	throw FDL::UnsupportedException("File Creation is not supported on Windows yet");
+	return false;
+}
+
+bool _deleteFile_Platform(const char* path)
+{
+	throw FDL::UnsupportedException("File Deletion is not supported on Windows yet");
+	return false;
+}
+
+bool _getStatus_Platform(const char* path, FDL::FileStatus& status)
+{
+	throw FDL::UnsupportedException("File status is not supported on Windows yet");
+	return false;
+}
+
+void* _openDirectory_Platform(const char* path)
+{
+	throw FDL::UnsupportedException("Directory reading is not supported on Windows yet");
+	return NULL;
+}
+
+const char* _readDirectory_Platform(void* p_directory)
+{
+	throw FDL::UnsupportedException("Directory reading is not supported on Windows yet");
+	return NULL;
+}
+
+void _closeDirectory_Platform(void* p_directory)
+{
+	throw FDL::UnsupportedException("Directory reading is not supported on Windows yet");
+}
+
+bool _getLinkStatus_Platform(const char* path, FDL::Uint64& device, FDL::Uint64& inode,
+	bool& isLink, bool& isDirectory)
+{
+	throw FDL::UnsupportedException("Path canonicalization is not supported on Windows yet");
+	return false;
+}
+
+bool _getIdentity_Platform(const char* path, FDL::Uint64& device, FDL::Uint64& inode)
+{
+	throw FDL::UnsupportedException("Path canonicalization is not supported on Windows yet");
+	return false;
+}
+
+bool _resolvePath_Platform(const char* path, std::string& resolved)
+{
+	throw FDL::UnsupportedException("Path canonicalization is not supported on Windows yet");
+	return false;
+}
+
+bool _getWorkingDirectory_Platform(std::string& directory)
+{
+	throw FDL::UnsupportedException("Path canonicalization is not supported on Windows yet");
+	return false;
+}
+
+int _openDescriptor_Platform(const char* path, bool write)
+{
+	throw FDL::UnsupportedException("Handle caching is not supported on Windows yet");
+	return -1;
+}
+
+void _closeDescriptor_Platform(int descriptor)
+{
+	throw FDL::UnsupportedException("Handle caching is not supported on Windows yet");
+}
+
+FDL::Int64 _readAt_Platform(int descriptor, char* buffer, FDL::Int64 size, FDL::Int64 offset)
+{
+	throw FDL::UnsupportedException("Handle caching is not supported on Windows yet");
+	return -1;
+}
+
+bool _writeAt_Platform(int descriptor, const char* data, FDL::Int64 size, FDL::Int64 offset)
+{
+	throw FDL::UnsupportedException("Handle caching is not supported on Windows yet");
+	return false;
+}
+
+FDL::Int64 _getDescriptorSize_Platform(int descriptor)
+{
+	throw FDL::UnsupportedException("Handle caching is not supported on Windows yet");
+	return -1;
+}
+
+bool _moveFile_Platform(const char* path, const char* newPath, bool recursive)
+{
+	throw FDL::UnsupportedException("File moving is not supported on Windows yet");
+	return false;
+}
+
+int _createTemporary_Platform(const char* directory, std::string& temporaryPath)
+{
+	throw FDL::UnsupportedException("Temporary files are not supported on Windows yet");
+	return -1;
+}
+
+bool _publishTemporary_Platform(int descriptor, const char* temporaryPath, const char* path)
+{
+	throw FDL::UnsupportedException("Temporary files are not supported on Windows yet");
+	return false;
+}
+
+bool _diskUsage_Platform(const char* path, const FDL::DiskUsageOptions& options, FDL::Arena* p_arena,
+	FDL::DiskUsage& usage)
+{
+	throw FDL::UnsupportedException("Disk usage is not supported on Windows yet");
+	return false;
+}
+
+bool _copyTree_Platform(const char* source, const char* destination, const FDL::CopyOptions& options,
+	FDL::Uint64& copied, FDL::Uint64& failed)
+{
+	throw FDL::UnsupportedException("Directory copying is not supported on Windows yet");
+	return false;
+}
+
+bool _diffTree_Platform(const char* path, const char* otherPath, const FDL::DiffOptions& options,
+	const std::function<void(const FDL::DiffEntry&)>& callback, FDL::Arena* p_arena)
+{
+	throw FDL::UnsupportedException("Directory comparison is not supported on Windows yet");
+	return false;
+}
+
+bool _writeSnapshot_Platform(const char* path, const char* snapshotPath)
+{
+	throw FDL::UnsupportedException("Directory snapshots are not supported on Windows yet");
+	return false;
+}
+
+bool _diffSnapshot_Platform(const char* snapshotPath, const char* path, const FDL::DiffOptions& options,
+	const std::function<void(const FDL::DiffEntry&)>& callback, FDL::Arena* p_arena)
+{
+	throw FDL::UnsupportedException("Directory snapshots are not supported on Windows yet");
+	return false;
+}
+
+// TODO: Create Windows Handling
+
+#endif /* _FDL_WINDOWS */
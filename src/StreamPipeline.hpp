@@ -0,0 +1,247 @@
+#ifndef _FDL_STREAM_PIPELINE_H
+#define _FDL_STREAM_PIPELINE_H
+
+#include <FDL/FDL.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////
+//	Stream Pipeline
+///////////////////////////////////////
+
+//	Overlaps the I/O of a FileStream with the caller. A helper thread either
+//	reads ahead into, or writes behind from, a fixed set of buffers, so at
+//	most bufferCount buffers are ever in flight
+class _StreamPipeline
+{
+public:
+
+	enum Mode
+	{
+		READ_AHEAD,
+		WRITE_BEHIND
+	};
+private:
+
+	struct Buffer
+	{
+		std::vector<char> data;
+		std::size_t size;
+		std::size_t offset;
+	};
+
+	Mode m_mode;
+	std::function<FDL::Int64(char*, FDL::Int64)> m_reader;
+	std::function<bool(const char*, FDL::Int64)> m_writer;
+	FDL::Int64 m_startPosition;
+	FDL::Int64 m_position;
+
+	std::vector<Buffer> m_buffers;
+	std::vector<Buffer*> m_free;
+	std::deque<Buffer*> m_queue;
+	Buffer* mp_current;
+
+	std::mutex m_mutex;
+	std::condition_variable m_changed;
+	bool m_writing;
+	bool m_finished;
+	bool m_failed;
+	bool m_stopping;
+	std::thread m_thread;
+
+	void _readLoop()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for(;;)
+		{
+			m_changed.wait(lock, [this] { return m_stopping || !m_free.empty(); });
+			if(m_stopping) return;
+			Buffer* p_buffer = m_free.back();
+			m_free.pop_back();
+
+			lock.unlock();
+			FDL::Int64 readSize = m_reader(&p_buffer->data[0], static_cast<FDL::Int64>(p_buffer->data.size()));
+			lock.lock();
+
+			if(readSize <= 0)
+			{
+				m_free.push_back(p_buffer);
+				m_finished = true;
+				m_failed = readSize < 0;
+				m_changed.notify_all();
+				return;
+			}
+			p_buffer->size = static_cast<std::size_t>(readSize);
+			p_buffer->offset = 0;
+			m_queue.push_back(p_buffer);
+			m_changed.notify_all();
+		}
+	}
+
+	void _writeLoop()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for(;;)
+		{
+			m_changed.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+			if(m_queue.empty()) return;
+			Buffer* p_buffer = m_queue.front();
+			m_queue.pop_front();
+			m_writing = true;
+
+			lock.unlock();
+			bool written = m_writer(&p_buffer->data[0], static_cast<FDL::Int64>(p_buffer->size));
+			lock.lock();
+
+			if(!written) m_failed = true;
+			m_writing = false;
+			m_free.push_back(p_buffer);
+			m_changed.notify_all();
+		}
+	}
+public:
+
+	_StreamPipeline(Mode mode, std::size_t bufferSize, std::size_t bufferCount, FDL::Int64 startPosition,
+		std::function<FDL::Int64(char*, FDL::Int64)> reader, std::function<bool(const char*, FDL::Int64)> writer)
+		: m_mode(mode), m_reader(reader), m_writer(writer), m_startPosition(startPosition), m_position(0),
+		m_buffers(std::max<std::size_t>(bufferCount, 2)), mp_current(NULL),
+		m_writing(false), m_finished(false), m_failed(false), m_stopping(false)
+	{
+		for(std::size_t i = 0; i < m_buffers.size(); ++i)
+		{
+			m_buffers[i].data.resize(std::max<std::size_t>(bufferSize, 1));
+			m_buffers[i].size = 0;
+			m_buffers[i].offset = 0;
+			m_free.push_back(&m_buffers[i]);
+		}
+		m_thread = std::thread(mode == READ_AHEAD ? &_StreamPipeline::_readLoop : &_StreamPipeline::_writeLoop, this);
+	}
+
+	~_StreamPipeline()
+	{
+		stop();
+	}
+
+	_StreamPipeline(const _StreamPipeline&) = delete;
+	_StreamPipeline& operator=(const _StreamPipeline&) = delete;
+
+	Mode getMode() const
+	{
+		return m_mode;
+	}
+
+	//	The position the caller has read or written up to
+	FDL::Int64 getPosition() const
+	{
+		return m_startPosition + m_position;
+	}
+
+	//	Copies up to size read-ahead bytes into buffer, waiting for the helper
+	//	when none are ready
+	FDL::Int64 read(char* buffer, FDL::Int64 size)
+	{
+		FDL::Int64 copied = 0;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while(copied < size)
+		{
+			if(mp_current == NULL || mp_current->offset == mp_current->size)
+			{
+				if(mp_current != NULL)
+				{
+					m_free.push_back(mp_current);
+					mp_current = NULL;
+					m_changed.notify_all();
+				}
+				m_changed.wait(lock, [this] { return !m_queue.empty() || m_finished; });
+				if(m_queue.empty()) break;
+				mp_current = m_queue.front();
+				m_queue.pop_front();
+			}
+
+			//	The current buffer belongs to the caller alone
+			lock.unlock();
+			std::size_t chunk = std::min(static_cast<std::size_t>(size - copied), mp_current->size - mp_current->offset);
+			std::memcpy(buffer + copied, &mp_current->data[mp_current->offset], chunk);
+			mp_current->offset += chunk;
+			copied += static_cast<FDL::Int64>(chunk);
+			lock.lock();
+		}
+		m_position += copied;
+		return copied;
+	}
+
+	//	Copies data into the write-behind buffers, waiting for the helper when
+	//	every buffer is queued, false if an earlier write failed
+	bool write(const char* data, FDL::Int64 size)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while(size > 0)
+		{
+			if(mp_current == NULL)
+			{
+				m_changed.wait(lock, [this] { return !m_free.empty(); });
+				mp_current = m_free.back();
+				m_free.pop_back();
+				mp_current->size = 0;
+			}
+
+			lock.unlock();
+			std::size_t chunk = std::min(static_cast<std::size_t>(size), mp_current->data.size() - mp_current->size);
+			std::memcpy(&mp_current->data[mp_current->size], data, chunk);
+			mp_current->size += chunk;
+			data += chunk;
+			size -= static_cast<FDL::Int64>(chunk);
+			m_position += static_cast<FDL::Int64>(chunk);
+			lock.lock();
+
+			if(mp_current->size == mp_current->data.size())
+			{
+				m_queue.push_back(mp_current);
+				mp_current = NULL;
+				m_changed.notify_all();
+			}
+		}
+		return !m_failed;
+	}
+
+	//	Queues the partly filled buffer and waits until everything queued is
+	//	written, false if any write failed
+	bool flush()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if(m_mode == WRITE_BEHIND && mp_current != NULL)
+		{
+			if(mp_current->size > 0) m_queue.push_back(mp_current);
+			else m_free.push_back(mp_current);
+			mp_current = NULL;
+			m_changed.notify_all();
+		}
+		m_changed.wait(lock, [this] { return (m_mode == READ_AHEAD || m_queue.empty()) && !m_writing; });
+		return !m_failed;
+	}
+
+	//	Writes out what is queued, then ends the helper thread. Never throws:
+	//	the thread is joined at most once and never by itself, which leaves
+	//	the mutex and the join nothing to fail on
+	bool stop() noexcept
+	{
+		if(!m_thread.joinable()) return !m_failed;
+		bool flushed = flush();
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_changed.notify_all();
+		m_thread.join();
+		return flushed;
+	}
+};
+
+#endif /* _FDL_STREAM_PIPELINE_H */
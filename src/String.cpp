@@ -0,0 +1,106 @@
+#include <FDL/FDL.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+using namespace FDL;
+
+const String String::null_str(static_cast<const char*>(NULL));
+
+String::String(char* string) : String(static_cast<const char*>(string)) {}
+
+String::String(char* string, std::size_t size) : String(static_cast<const char*>(string), size) {}
+
+String::String(const char* string) : String(string, string == NULL ? 0 : std::strlen(string)) {}
+
+String::String(const char* string, std::size_t size) : m_size(0), m_str(NULL), m_owner(true)
+{
+	if(string == NULL) return;
+	while(m_size < size && string[m_size] != '\0') ++m_size;
+	char* p_buffer = new char[m_size + 1];
+	std::memcpy(p_buffer, string, m_size);
+	p_buffer[m_size] = '\0';
+	m_str = p_buffer;
+}
+
+String::String(const String& string) : String(string.m_str, string.m_size) {}
+
+String::String(String&& string) noexcept : m_size(string.m_size), m_str(string.m_str), m_owner(string.m_owner)
+{
+	string.m_size = 0;
+	string.m_str = NULL;
+}
+
+String::~String()
+{
+	if(m_owner) delete[] m_str;
+}
+
+String& String::operator=(char* string)
+{
+	return *this = String(string);
+}
+
+String& String::operator=(const char* string)
+{
+	return *this = String(string);
+}
+
+String& String::operator=(const String& string)
+{
+	if(this != &string) *this = String(string);
+	return *this;
+}
+
+String& String::operator=(String&& string) noexcept
+{
+	if(this == &string) return *this;
+	if(m_owner) delete[] m_str;
+	m_size = string.m_size;
+	m_str = string.m_str;
+	m_owner = string.m_owner;
+	string.m_size = 0;
+	string.m_str = NULL;
+	return *this;
+}
+
+String::operator char*() const
+{
+	return const_cast<char*>(m_str);
+}
+
+String::operator const char*() const
+{
+	return m_str;
+}
+
+char* String::operator[](int position)
+{
+	if(position < 0 || static_cast<std::size_t>(position) >= m_size)
+		throw std::out_of_range("String position is beyond size");
+	return const_cast<char*>(m_str) + position;
+}
+
+const char* String::c_str() const
+{
+	return m_str;
+}
+
+std::size_t String::size() const
+{
+	return m_size;
+}
+
+bool String::isNullStr() const
+{
+	return m_str == NULL;
+}
+
+String String::borrow(const char* string, std::size_t size)
+{
+	String borrowed(static_cast<const char*>(NULL));
+	borrowed.m_size = size;
+	borrowed.m_str = string;
+	borrowed.m_owner = false;
+	return borrowed;
+}
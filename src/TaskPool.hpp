@@ -0,0 +1,106 @@
+#ifndef _FDL_TASK_POOL_H
+#define _FDL_TASK_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////
+//	Task Pool
+///////////////////////////////////////
+
+//	A fixed set of worker threads used by bulk filesystem operations. Tasks
+//	may submit further tasks, wait() returns once every task has finished and
+//	rethrows the first exception a task raised
+class _TaskPool
+{
+private:
+
+	std::mutex m_mutex;
+	std::condition_variable m_taskReady;
+	std::condition_variable m_idle;
+	std::deque<std::function<void()> > m_tasks;
+	std::vector<std::thread> m_workers;
+	std::size_t m_pending;
+	bool m_stopping;
+	std::exception_ptr m_error;
+
+	void _run()
+	{
+		for(;;)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_taskReady.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+				if(m_tasks.empty()) return;
+				task = std::move(m_tasks.front());
+				m_tasks.pop_front();
+			}
+			try
+			{
+				task();
+			}
+			catch(...)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if(!m_error) m_error = std::current_exception();
+			}
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if(--m_pending == 0) m_idle.notify_all();
+		}
+	}
+public:
+
+	//	threadCount of 0 uses the hardware concurrency
+	explicit _TaskPool(unsigned threadCount = 0) : m_pending(0), m_stopping(false)
+	{
+		if(threadCount == 0) threadCount = std::thread::hardware_concurrency();
+		if(threadCount == 0) threadCount = 1;
+		m_workers.reserve(threadCount);
+		for(unsigned i = 0; i < threadCount; ++i)
+			m_workers.push_back(std::thread(&_TaskPool::_run, this));
+	}
+
+	~_TaskPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_taskReady.notify_all();
+		for(std::size_t i = 0; i < m_workers.size(); ++i) m_workers[i].join();
+	}
+
+	_TaskPool(const _TaskPool&) = delete;
+	_TaskPool& operator=(const _TaskPool&) = delete;
+
+	void submit(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.push_back(std::move(task));
+			++m_pending;
+		}
+		m_taskReady.notify_one();
+	}
+
+	void wait()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_idle.wait(lock, [this] { return m_pending == 0; });
+		if(m_error)
+		{
+			std::exception_ptr error = m_error;
+			m_error = std::exception_ptr();
+			std::rethrow_exception(error);
+		}
+	}
+};
+
+#endif /* _FDL_TASK_POOL_H */
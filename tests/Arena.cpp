@@ -0,0 +1,111 @@
+#include "Platform.hpp"
+
+#include "Test.hpp"
+
+#include <cstdint>
+#include <set>
+#include <string>
+
+using namespace FDL;
+
+static bool _isAligned(const void* p_memory, std::size_t alignment)
+{
+	return reinterpret_cast<std::uintptr_t>(p_memory) % alignment == 0;
+}
+
+static void _testAllocate()
+{
+	Arena arena(1024);
+	FDL_CHECK(arena.getUsed() == 0);
+
+	char* p_byte = static_cast<char*>(arena.allocate(1, 1));
+	FDL_CHECK(_isAligned(arena.allocate(8, 8), 8));
+	FDL_CHECK(_isAligned(arena.allocate(3, 64), 64));
+	FDL_CHECK(_isAligned(arena.allocate(24), alignof(std::max_align_t)));
+	FDL_CHECK(arena.getUsed() == 1 + 8 + 3 + 24);
+
+	//	A large block gets a chunk of its own, later small blocks still come
+	//	from the current chunk
+	char* p_small = static_cast<char*>(arena.allocate(1, 1));
+	char* p_large = static_cast<char*>(arena.allocate(4096, 16));
+	FDL_CHECK(_isAligned(p_large, 16));
+	p_large[0] = p_large[4095] = 'l';
+	char* p_after = static_cast<char*>(arena.allocate(1, 1));
+	FDL_CHECK(p_after == p_small + 1);
+	FDL_CHECK(p_after - p_byte < 1024);
+
+	//	Filling past a chunk moves on to a new one
+	for(int i = 0; i < 64; ++i) FDL_CHECK(arena.allocate(100, 1) != NULL);
+	FDL_CHECK(arena.getUsed() == 1 + 8 + 3 + 24 + 1 + 4096 + 1 + 64 * 100);
+
+	arena.release();
+	FDL_CHECK(arena.getUsed() == 0);
+	FDL_CHECK(arena.allocate(16) != NULL);
+	FDL_CHECK(arena.getUsed() == 16);
+}
+
+static void _testStrings()
+{
+	Arena arena;
+
+	//	copyString borrows its copy, copies of the String own theirs
+	const char text[] = "borrowed text";
+	String borrowed = arena.copyString(text, 8);
+	FDL_CHECK(_equals(borrowed.c_str(), "borrowed"));
+	FDL_CHECK(borrowed.size() == 8);
+	FDL_CHECK(borrowed.c_str() != text);
+	String owned(borrowed);
+	FDL_CHECK(owned.c_str() != borrowed.c_str());
+	FDL_CHECK(arena.copyString(NULL, 0).isNullStr());
+
+	arena.release();
+	FDL_CHECK(_equals(owned.c_str(), "borrowed"));
+}
+
+static void _testContainedFiles()
+{
+	std::string root = _makeScratch("Arena");
+	std::set<std::string> expected;
+	for(int i = 0; i < 50; ++i)
+	{
+		std::string name = "file" + std::to_string(i) + ".txt";
+		_writeFile(root + "/" + name, "");
+		expected.insert(name);
+	}
+
+	//	The arena variant lists the same Files with their paths in arena,
+	//	copied Files outlive it
+	Directory directory(String(root.c_str()));
+	Arena arena;
+	File kept(String("placeholder"));
+	{
+		ImmutableList<File> files = directory.getContainedFiles(arena);
+		FDL_CHECK(arena.getUsed() > 50 * root.size());
+		std::set<std::string> names;
+		for(std::size_t i = 0; i < files.getSize(); ++i)
+		{
+			names.insert(files.getValues()[i].getName().c_str());
+			FDL_CHECK(_equals(files.getValues()[i].getExtension().c_str(), "txt"));
+		}
+		FDL_CHECK(names == expected);
+		kept = files.getValues()[0];
+	}
+	arena.release();
+	FDL_CHECK(expected.count(kept.getName().c_str()) == 1);
+	FDL_CHECK(kept.getStatus().exists);
+
+	ImmutableList<File> files = directory.getContainedFiles();
+	FDL_CHECK(files.getSize() == expected.size());
+
+	FDL_CHECK_THROWS(Directory(String((root + "/missing").c_str())).getContainedFiles(arena),
+		File::FileMissingException);
+	_removeScratch(root);
+}
+
+int main()
+{
+	_testAllocate();
+	_testStrings();
+	if(FDL_IS_POSIX) _testContainedFiles();
+	return s_failures == 0 ? 0 : 1;
+}
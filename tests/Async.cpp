@@ -0,0 +1,212 @@
+#include "Platform.hpp"
+
+#include "Test.hpp"
+
+#ifdef FDL_HAS_COROUTINES
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <set>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+
+using namespace FDL;
+
+//	A coroutine running as soon as it is called, the caller waits on the
+//	std::promise it owns and sets at its end
+struct _Detached
+{
+	struct promise_type
+	{
+		_Detached get_return_object() { return _Detached(); }
+		std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+		std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+//	Runs every task right away on the posting thread, counting them
+class _InlineExecutor : public Executor
+{
+public:
+
+	std::atomic<int> postCount;
+
+	_InlineExecutor() : postCount(0) {}
+
+	void post(std::function<void()> task)
+	{
+		++postCount;
+		task();
+	}
+};
+
+static _Detached _fileOperations(std::string path, Executor& executor, std::promise<void> done)
+{
+	//	Every operation runs on executor and its result comes back from
+	//	co_await
+	File file(String(path.c_str()));
+	FDL_CHECK(co_await file.asyncCreate(executor));
+	{
+		FileStream stream = co_await file.asyncOpen(executor);
+		co_await stream.asyncWrite(executor, "contents", 8);
+		FDL_CHECK(stream.flush());
+		stream.seekRead(0);
+		char buffer[8];
+		FDL_CHECK(co_await stream.asyncRead(executor, buffer, 8) == 8);
+		FDL_CHECK(std::string(buffer, 8) == "contents");
+	}
+	FileStatus status = co_await file.asyncStat(executor);
+	FDL_CHECK(status.exists && !status.directory && status.size == 8);
+	FDL_CHECK(co_await file.asyncRemove(executor));
+
+	//	Exceptions of the operation are rethrown from co_await
+	bool thrown = false;
+	try
+	{
+		co_await file.asyncOpen(executor);
+	}
+	catch(const File::FileMissingException&)
+	{
+		thrown = true;
+	}
+	FDL_CHECK(thrown);
+	done.set_value();
+}
+
+static void _testFileOperations()
+{
+	std::string scratch = _makeScratch("Async");
+
+	_InlineExecutor inlineExecutor;
+	std::promise<void> inlineDone;
+	std::future<void> inlineDoneFuture = inlineDone.get_future();
+	_fileOperations(scratch + "/inline", inlineExecutor, std::move(inlineDone));
+	inlineDoneFuture.wait();
+	FDL_CHECK(inlineExecutor.postCount == 7);
+
+	ThreadPoolExecutor pool(2);
+	std::promise<void> poolDone;
+	std::future<void> poolDoneFuture = poolDone.get_future();
+	_fileOperations(scratch + "/pool", pool, std::move(poolDone));
+	poolDoneFuture.wait();
+
+	_removeScratch(scratch);
+}
+
+static _Detached _resumeOperations(std::string path, Executor& executor, _InlineExecutor& resumeExecutor,
+	std::thread::id& resumedOn, std::promise<void> done)
+{
+	//	resumeOn hands the coroutine back through another Executor, the
+	//	default Executor runs operations given none
+	File file(String(path.c_str()));
+	FileStatus status = co_await file.asyncStat(executor).resumeOn(resumeExecutor);
+	FDL_CHECK(status.exists && status.directory);
+	resumedOn = std::this_thread::get_id();
+	FDL_CHECK(!(co_await file.asyncCreate()));
+	done.set_value();
+}
+
+static void _testExecutors()
+{
+	std::string scratch = _makeScratch("Async");
+
+	ThreadPoolExecutor pool(1);
+	_InlineExecutor resumeExecutor;
+	_InlineExecutor defaultExecutor;
+	setDefaultExecutor(&defaultExecutor);
+	FDL_CHECK(&getDefaultExecutor() == &defaultExecutor);
+
+	std::thread::id resumedOn;
+	std::promise<void> done;
+	std::future<void> doneFuture = done.get_future();
+	_resumeOperations(scratch, pool, resumeExecutor, resumedOn, std::move(done));
+	doneFuture.wait();
+	FDL_CHECK(resumeExecutor.postCount == 1);
+	FDL_CHECK(resumedOn != std::this_thread::get_id());
+	FDL_CHECK(defaultExecutor.postCount == 1);
+
+	setDefaultExecutor(NULL);
+	FDL_CHECK(&getDefaultExecutor() != &defaultExecutor);
+	_removeScratch(scratch);
+}
+
+static _Detached _entries(std::string path, Executor& executor, Arena* p_arena, std::set<std::string>& names,
+	std::promise<void> done)
+{
+	Directory directory(String(path.c_str()));
+	AsyncGenerator<File> entries = p_arena != NULL ? directory.asyncEntries(executor, *p_arena)
+		: directory.asyncEntries(executor);
+	try
+	{
+		while(File* p_file = co_await entries.next()) names.insert(p_file->getName().c_str());
+	}
+	catch(const File::FileMissingException&)
+	{
+		names.insert("missing");
+	}
+	done.set_value();
+}
+
+static void _testEntries()
+{
+	std::string scratch = _makeScratch("Async");
+
+	//	More entries than one batch reads
+	std::set<std::string> expected;
+	for(int i = 0; i < 150; ++i)
+	{
+		std::string name = "entry" + std::to_string(i);
+		_writeFile(scratch + "/" + name, "");
+		expected.insert(name);
+	}
+	mkdir((scratch + "/directory").c_str(), 0755);
+	expected.insert("directory");
+
+	ThreadPoolExecutor pool(2);
+	std::set<std::string> names;
+	std::promise<void> done;
+	std::future<void> doneFuture = done.get_future();
+	_entries(scratch, pool, NULL, names, std::move(done));
+	doneFuture.wait();
+	FDL_CHECK(names == expected);
+
+	Arena arena;
+	std::set<std::string> arenaNames;
+	std::promise<void> arenaDone;
+	std::future<void> arenaDoneFuture = arenaDone.get_future();
+	_entries(scratch, pool, &arena, arenaNames, std::move(arenaDone));
+	arenaDoneFuture.wait();
+	FDL_CHECK(arenaNames == expected);
+
+	std::set<std::string> missingNames;
+	std::promise<void> missingDone;
+	std::future<void> missingDoneFuture = missingDone.get_future();
+	_entries(scratch + "/missing", pool, NULL, missingNames, std::move(missingDone));
+	missingDoneFuture.wait();
+	FDL_CHECK(missingNames == std::set<std::string>({ "missing" }));
+
+	_removeScratch(scratch);
+}
+
+int main()
+{
+	if(!FDL_IS_POSIX) return 0;
+	_testFileOperations();
+	_testExecutors();
+	_testEntries();
+	return s_failures == 0 ? 0 : 1;
+}
+
+#else
+
+int main()
+{
+	return 0;
+}
+
+#endif
@@ -0,0 +1,73 @@
+#include "Platform.hpp"
+
+#include "Test.hpp"
+
+#include <climits>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+
+using namespace FDL;
+
+static std::string _canonical(const std::string& path)
+{
+	return File(String(path.c_str())).canonical().getFullPath().c_str();
+}
+
+static void _testResolve()
+{
+	std::string scratch = _makeScratch("Canonical");
+	char resolved[PATH_MAX];
+	std::string root = realpath(scratch.c_str(), resolved);
+	mkdir((scratch + "/real").c_str(), 0755);
+	mkdir((scratch + "/real/sub").c_str(), 0755);
+	_writeFile(scratch + "/real/sub/file", "contents");
+	symlink("real", (scratch + "/link").c_str());
+
+	FDL_CHECK(_canonical(scratch + "/link/sub/file") == root + "/real/sub/file");
+	FDL_CHECK(_canonical(scratch + "/link/sub/../sub/./file") == root + "/real/sub/file");
+	FDL_CHECK(_canonical(scratch + "//real///sub") == root + "/real/sub");
+	FDL_CHECK_THROWS(_canonical(scratch + "/link/missing/file"), File::FileMissingException);
+
+	//	Relative paths resolve against the working directory
+	char previous[PATH_MAX];
+	FDL_CHECK(getcwd(previous, sizeof(previous)) != NULL);
+	FDL_CHECK(chdir((scratch + "/link").c_str()) == 0);
+	FDL_CHECK(_canonical("sub/file") == root + "/real/sub/file");
+	FDL_CHECK(chdir(previous) == 0);
+
+	_removeScratch(scratch);
+}
+
+static void _testRetarget()
+{
+	std::string scratch = _makeScratch("CanonicalRetarget");
+	char resolved[PATH_MAX];
+	std::string root = realpath(scratch.c_str(), resolved);
+	mkdir((scratch + "/real").c_str(), 0755);
+	_writeFile(scratch + "/real/file", "contents");
+	symlink("real", (scratch + "/link").c_str());
+	FDL_CHECK(_canonical(scratch + "/link/file") == root + "/real/file");
+
+	//	The link still leads to the same directory, under a new name that
+	//	only resolving again finds, without invalidating the cache
+	FDL_CHECK(rename((scratch + "/real").c_str(), (scratch + "/moved").c_str()) == 0);
+	FDL_CHECK(unlink((scratch + "/link").c_str()) == 0 && symlink("moved", (scratch + "/link").c_str()) == 0);
+	FDL_CHECK(_canonical(scratch + "/link/file") == root + "/moved/file");
+
+	//	A link retargeted to another directory is noticed as well
+	mkdir((scratch + "/other").c_str(), 0755);
+	_writeFile(scratch + "/other/file", "other");
+	FDL_CHECK(unlink((scratch + "/link").c_str()) == 0 && symlink("other", (scratch + "/link").c_str()) == 0);
+	FDL_CHECK(_canonical(scratch + "/link/file") == root + "/other/file");
+
+	_removeScratch(scratch);
+}
+
+int main()
+{
+	if(!FDL_IS_POSIX) return 0;
+	_testResolve();
+	_testRetarget();
+	return s_failures == 0 ? 0 : 1;
+}
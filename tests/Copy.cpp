@@ -0,0 +1,131 @@
+#include "Platform.hpp"
+
+#include "Test.hpp"
+
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+using namespace FDL;
+
+//	Fills root with two files, a subdirectory and a link
+static void _makeTree(const std::string& root)
+{
+	mkdir((root + "/sub").c_str(), 0755);
+	_writeFile(root + "/file", "contents");
+	_writeFile(root + "/sub/nested", "nested contents");
+	symlink("file", (root + "/link").c_str());
+}
+
+static std::vector<DiffEntry> _diff(const std::string& left, const std::string& right)
+{
+	std::vector<DiffEntry> changes;
+	Directory(String(left.c_str())).diff(Directory(String(right.c_str())), [&](const DiffEntry& entry)
+	{
+		changes.push_back(entry);
+	});
+	return changes;
+}
+
+static void _testCopy()
+{
+	std::string scratch = _makeScratch("Copy");
+	std::string source = scratch + "/source";
+	std::string destination = scratch + "/destination";
+	mkdir(source.c_str(), 0755);
+	_makeTree(source);
+
+	Directory directory(String(source.c_str()));
+	FDL_CHECK(directory.copyTo(Directory(String(destination.c_str()))) == 3);
+	FDL_CHECK(_readFile(destination + "/sub/nested") == "nested contents");
+
+	char target[16];
+	ssize_t length = readlink((destination + "/link").c_str(), target, sizeof(target));
+	FDL_CHECK(length == 4 && std::string(target, 4) == "file");
+
+	//	Link times are kept too, so the copy compares equal right away
+	FDL_CHECK(_diff(source, destination).empty());
+
+	//	An incremental copy only touches what changed, links included
+	CopyOptions options;
+	options.skipUnchanged = true;
+	FDL_CHECK(directory.copyTo(Directory(String(destination.c_str())), options) == 0);
+	_writeFile(source + "/sub/nested", "changed contents, and longer");
+	FDL_CHECK(directory.copyTo(Directory(String(destination.c_str())), options) == 1);
+	FDL_CHECK(_readFile(destination + "/sub/nested") == "changed contents, and longer");
+
+	_removeScratch(scratch);
+}
+
+static void _testModes()
+{
+	std::string scratch = _makeScratch("CopyModes");
+	std::string source = scratch + "/source";
+	std::string destination = scratch + "/destination";
+	mkdir(source.c_str(), 0755);
+	mkdir((source + "/locked").c_str(), 0755);
+	_writeFile(source + "/locked/readonly", "first");
+	chmod((source + "/locked/readonly").c_str(), 0444);
+	chmod((source + "/locked").c_str(), 0555);
+
+	Directory directory(String(source.c_str()));
+	FDL_CHECK(directory.copyTo(Directory(String(destination.c_str()))) == 1);
+	struct stat status;
+	FDL_CHECK(stat((destination + "/locked/readonly").c_str(), &status) == 0 && (status.st_mode & 07777) == 0444);
+	FDL_CHECK(stat((destination + "/locked").c_str(), &status) == 0 && (status.st_mode & 07777) == 0555);
+
+	//	Copying again replaces the read-only file the first copy made
+	chmod((source + "/locked").c_str(), 0755);
+	chmod((source + "/locked/readonly").c_str(), 0644);
+	_writeFile(source + "/locked/readonly", "second, longer");
+	chmod((source + "/locked/readonly").c_str(), 0444);
+	chmod((source + "/locked").c_str(), 0555);
+	CopyOptions options;
+	options.skipUnchanged = true;
+	FDL_CHECK(directory.copyTo(Directory(String(destination.c_str())), options) == 1);
+	FDL_CHECK(_readFile(destination + "/locked/readonly") == "second, longer");
+	FDL_CHECK(stat((destination + "/locked").c_str(), &status) == 0 && (status.st_mode & 07777) == 0555);
+
+	chmod((source + "/locked").c_str(), 0755);
+	chmod((destination + "/locked").c_str(), 0755);
+	_removeScratch(scratch);
+}
+
+static void _testLinksAtDestination()
+{
+	std::string scratch = _makeScratch("CopyLinks");
+	std::string source = scratch + "/source";
+	std::string destination = scratch + "/destination";
+	mkdir(source.c_str(), 0755);
+	mkdir(destination.c_str(), 0755);
+	_writeFile(source + "/file", "contents");
+	_writeFile(scratch + "/outside", "untouched");
+
+	//	A link in the way is replaced, the file it points to is left alone
+	symlink("../outside", (destination + "/file").c_str());
+	FDL_CHECK(Directory(String(source.c_str())).copyTo(Directory(String(destination.c_str()))) == 1);
+	FDL_CHECK(_readFile(scratch + "/outside") == "untouched");
+	FDL_CHECK(_readFile(destination + "/file") == "contents");
+
+	_removeScratch(scratch);
+}
+
+static void _testCopyIntoSource()
+{
+	std::string scratch = _makeScratch("CopyInto");
+	Directory directory(String(scratch.c_str()));
+	FDL_CHECK_THROWS(directory.copyTo(Directory(String((scratch + "/inside/deeper").c_str()))), BadPathException);
+	FDL_CHECK_THROWS(directory.copyTo(directory), BadPathException);
+	FDL_CHECK(directory.getContainedFiles().getSize() == 0);
+	_removeScratch(scratch);
+}
+
+int main()
+{
+	if(!FDL_IS_POSIX) return 0;
+	_testCopy();
+	_testModes();
+	_testLinksAtDestination();
+	_testCopyIntoSource();
+	return s_failures == 0 ? 0 : 1;
+}
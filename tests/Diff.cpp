@@ -0,0 +1,187 @@
+#include "Platform.hpp"
+
+#include "Test.hpp"
+
+#include <algorithm>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+using namespace FDL;
+
+//	One change as +path, -path or ~path, with a trailing slash for a
+//	directory, so a whole scan compares as one sorted list
+static std::string _describe(const DiffEntry& entry)
+{
+	const char* p_change = entry.change == DiffEntry::ADDED ? "+" : entry.change == DiffEntry::REMOVED ? "-" : "~";
+	return p_change + std::string(entry.path.c_str()) + (entry.directory ? "/" : "");
+}
+
+static std::vector<std::string> _sorted(std::vector<std::string> changes)
+{
+	std::sort(changes.begin(), changes.end());
+	return changes;
+}
+
+//	Fills root with a file, a subdirectory holding another and an empty
+//	directory
+static void _makeTree(const std::string& root)
+{
+	mkdir(root.c_str(), 0755);
+	mkdir((root + "/sub").c_str(), 0755);
+	mkdir((root + "/empty").c_str(), 0755);
+	_writeFile(root + "/file", "contents");
+	_writeFile(root + "/sub/nested", "nested contents");
+}
+
+//	Changes every kind of entry the scan tells apart
+static void _changeTree(const std::string& root)
+{
+	_writeFile(root + "/sub/nested", "longer nested contents");
+	_writeFile(root + "/sub/added", "added");
+	std::remove((root + "/file").c_str());
+	mkdir((root + "/file").c_str(), 0755);
+	rmdir((root + "/empty").c_str());
+	mkdir((root + "/new").c_str(), 0755);
+	_writeFile(root + "/new/inside", "inside");
+}
+
+static void _testDiff()
+{
+	std::string scratch = _makeScratch("Diff");
+	std::string left = scratch + "/left";
+	std::string right = scratch + "/right";
+	_makeTree(left);
+	_makeTree(right);
+	_changeTree(right);
+
+	//	A directory on one side only is reported without its contents, a
+	//	file replaced by a directory as removed and added
+	std::vector<std::string> changes;
+	Directory(String(left.c_str())).diff(Directory(String(right.c_str())), [&](const DiffEntry& entry)
+	{
+		changes.push_back(_describe(entry));
+	});
+	std::vector<std::string> expected = { "+file/", "+new/", "+sub/added", "-empty/", "-file", "~sub/nested" };
+	FDL_CHECK(_sorted(changes) == expected);
+
+	//	The arena variant reports the same
+	Arena arena;
+	DiffOptions options;
+	options.threadCount = 1;
+	changes.clear();
+	Directory(String(left.c_str())).diff(Directory(String(right.c_str())), options, [&](const DiffEntry& entry)
+	{
+		changes.push_back(_describe(entry));
+	}, arena);
+	FDL_CHECK(_sorted(changes) == expected);
+
+	FDL_CHECK_THROWS(Directory(String(left.c_str())).diff(Directory(String((scratch + "/missing").c_str())),
+		[](const DiffEntry&) {}), File::FileMissingException);
+
+	_removeScratch(scratch);
+}
+
+static void _testSnapshot()
+{
+	std::string scratch = _makeScratch("Diff");
+	std::string root = scratch + "/root";
+	std::string snapshot = scratch + "/snapshot";
+	_makeTree(root);
+
+	//	A snapshot compares equal to its own tree, then reports the changes
+	//	diff reports between the two trees
+	Directory directory(String(root.c_str()));
+	directory.writeSnapshot(File(String(snapshot.c_str())));
+	std::vector<std::string> changes;
+	directory.diffSnapshot(File(String(snapshot.c_str())), [&](const DiffEntry& entry)
+	{
+		changes.push_back(_describe(entry));
+	});
+	FDL_CHECK(changes.empty());
+
+	_changeTree(root);
+	directory.diffSnapshot(File(String(snapshot.c_str())), [&](const DiffEntry& entry)
+	{
+		changes.push_back(_describe(entry));
+	});
+	std::vector<std::string> expected = { "+file/", "+new/", "+sub/added", "-empty/", "-file", "~sub/nested" };
+	FDL_CHECK(_sorted(changes) == expected);
+
+	_writeFile(scratch + "/damaged", "FDLSNAP1 and nothing sensible");
+	FDL_CHECK_THROWS(directory.diffSnapshot(File(String((scratch + "/damaged").c_str())), [](const DiffEntry&) {}),
+		File::FileFailException);
+	FDL_CHECK_THROWS(directory.diffSnapshot(File(String((scratch + "/missing").c_str())), [](const DiffEntry&) {}),
+		File::FileMissingException);
+
+	_removeScratch(scratch);
+}
+
+static void _testVanished()
+{
+	std::string scratch = _makeScratch("Diff");
+	std::string left = scratch + "/left";
+	std::string right = scratch + "/right";
+	_makeTree(left);
+	Directory(String(left.c_str())).copyTo(Directory(String(right.c_str())));
+	_writeFile(right + "/added", "added");
+
+	//	The copy keeps times, so only what the test changes is reported.
+	//	Both sides of sub are listed before added is reported, so sub is
+	//	still descended into after the callback removes it. Its contents
+	//	count as removed rather than failing the scan
+	std::vector<std::string> changes;
+	Directory(String(left.c_str())).diff(Directory(String(right.c_str())), [&](const DiffEntry& entry)
+	{
+		changes.push_back(_describe(entry));
+		std::remove((right + "/sub/nested").c_str());
+		rmdir((right + "/sub").c_str());
+	});
+	FDL_CHECK(_sorted(changes) == std::vector<std::string>({ "+added", "-sub/nested" }));
+
+	//	The same goes for the walk against a snapshot
+	std::string snapshot = scratch + "/snapshot";
+	Directory(String(left.c_str())).writeSnapshot(File(String(snapshot.c_str())));
+	_writeFile(left + "/added", "added");
+	changes.clear();
+	Directory(String(left.c_str())).diffSnapshot(File(String(snapshot.c_str())), [&](const DiffEntry& entry)
+	{
+		changes.push_back(_describe(entry));
+		std::remove((left + "/sub/nested").c_str());
+		rmdir((left + "/sub").c_str());
+	});
+	FDL_CHECK(_sorted(changes) == std::vector<std::string>({ "+added", "-sub/nested" }));
+
+	_removeScratch(scratch);
+}
+
+static void _testUnreadable()
+{
+	//	Permissions do not stop root
+	if(geteuid() == 0) return;
+	std::string scratch = _makeScratch("Diff");
+	std::string left = scratch + "/left";
+	std::string right = scratch + "/right";
+	_makeTree(left);
+	_makeTree(right);
+
+	//	Any other failure to list still stops the scan
+	chmod((right + "/sub").c_str(), 0);
+	FDL_CHECK_THROWS(Directory(String(left.c_str())).diff(Directory(String(right.c_str())), [](const DiffEntry&) {}),
+		File::FileFailException);
+	FDL_CHECK_THROWS(Directory(String(right.c_str())).writeSnapshot(File(String((scratch + "/snapshot").c_str()))),
+		File::FileFailException);
+	chmod((right + "/sub").c_str(), 0755);
+
+	_removeScratch(scratch);
+}
+
+int main()
+{
+	if(!FDL_IS_POSIX) return 0;
+	_testDiff();
+	_testSnapshot();
+	_testVanished();
+	_testUnreadable();
+	return s_failures == 0 ? 0 : 1;
+}
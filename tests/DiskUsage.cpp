@@ -0,0 +1,109 @@
+#include "Platform.hpp"
+
+#include "Test.hpp"
+
+#include <string>
+#include <sys/stat.h>
+
+using namespace FDL;
+
+static Uint64 _getSize(const std::string& path)
+{
+	struct stat status;
+	lstat(path.c_str(), &status);
+	return static_cast<Uint64>(status.st_size);
+}
+
+//	Fills root with a file, a hard link and a symbolic link to it and two
+//	subdirectories, one holding a file
+static void _makeTree(const std::string& root)
+{
+	_writeFile(root + "/data", std::string(100, 'd'));
+	link((root + "/data").c_str(), (root + "/twin").c_str());
+	symlink("data", (root + "/link").c_str());
+	mkdir((root + "/one").c_str(), 0755);
+	mkdir((root + "/two").c_str(), 0755);
+	_writeFile(root + "/one/a", std::string(10, 'a'));
+}
+
+static void _testTotals()
+{
+	std::string root = _makeScratch("DiskUsage");
+	_makeTree(root);
+	Uint64 directoryBytes = _getSize(root) + _getSize(root + "/one") + _getSize(root + "/two");
+
+	//	The hard link is counted once, the symbolic link as a link
+	Directory directory(String(root.c_str()));
+	DiskUsage usage = directory.diskUsage();
+	FDL_CHECK(_equals(usage.path.c_str(), root.c_str()));
+	FDL_CHECK(usage.fileCount == 3);
+	FDL_CHECK(usage.directoryCount == 3);
+	FDL_CHECK(usage.skippedCount == 0);
+	FDL_CHECK(usage.apparentBytes == 100 + 4 + 10 + directoryBytes);
+	FDL_CHECK(usage.allocatedBytes > 0);
+	FDL_CHECK(usage.subdirectories.getSize() == 0);
+
+	DiskUsageOptions options;
+	options.deduplicateHardLinks = false;
+	options.threadCount = 1;
+	usage = directory.diskUsage(options);
+	FDL_CHECK(usage.fileCount == 4);
+	FDL_CHECK(usage.apparentBytes == 200 + 4 + 10 + directoryBytes);
+
+	FDL_CHECK_THROWS(Directory(String((root + "/missing").c_str())).diskUsage(), File::FileMissingException);
+	_removeScratch(root);
+}
+
+static void _testRollups()
+{
+	std::string root = _makeScratch("DiskUsage");
+	_makeTree(root);
+
+	//	Each immediate subdirectory gets the totals below it, itself included
+	DiskUsageOptions options;
+	options.subdirectoryRollups = true;
+	Arena arena;
+	DiskUsage usage = Directory(String(root.c_str())).diskUsage(options, arena);
+	FDL_CHECK(usage.fileCount == 3);
+	FDL_CHECK(usage.subdirectories.getSize() == 2);
+	bool foundOne = false;
+	for(std::size_t i = 0; i < usage.subdirectories.getSize(); ++i)
+	{
+		const DiskUsage& subdirectory = usage.subdirectories.getValues()[i];
+		FDL_CHECK(subdirectory.directoryCount == 1);
+		if(std::string(subdirectory.path.c_str()) != root + "/one") continue;
+		foundOne = true;
+		FDL_CHECK(subdirectory.fileCount == 1);
+		FDL_CHECK(subdirectory.apparentBytes == 10 + _getSize(root + "/one"));
+	}
+	FDL_CHECK(foundOne);
+
+	_removeScratch(root);
+}
+
+static void _testSkipped()
+{
+	//	Permissions do not stop root
+	if(geteuid() == 0) return;
+	std::string root = _makeScratch("DiskUsage");
+	_makeTree(root);
+
+	//	An unreadable directory is counted as itself and once as skipped
+	chmod((root + "/one").c_str(), 0);
+	DiskUsage usage = Directory(String(root.c_str())).diskUsage();
+	FDL_CHECK(usage.fileCount == 2);
+	FDL_CHECK(usage.directoryCount == 3);
+	FDL_CHECK(usage.skippedCount == 1);
+	chmod((root + "/one").c_str(), 0755);
+
+	_removeScratch(root);
+}
+
+int main()
+{
+	if(!FDL_IS_POSIX) return 0;
+	_testTotals();
+	_testRollups();
+	_testSkipped();
+	return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+#include "Platform.hpp"
+#include "HandleCache.hpp"
+
+#include "Test.hpp"
+
+#include <cstdlib>
+#include <sys/stat.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace FDL;
+
+static std::string _createFile(const char* name)
+{
+	const char* p_directory = std::getenv("TMPDIR");
+	std::string path = std::string(p_directory != NULL ? p_directory : "/tmp") + "/FDLTestHandleCache_" + name;
+	std::ofstream(path.c_str()) << "contents";
+	return path;
+}
+
+static void _testSharing()
+{
+	std::string path = _createFile("sharing");
+	FDL_CHECK(enableHandleCache(64));
+
+	//	Every acquire of a path shares one descriptor until it is invalidated
+	std::shared_ptr<_CachedHandle> p_first = _acquireHandle(path.c_str());
+	std::shared_ptr<_CachedHandle> p_second = _acquireHandle(path.c_str());
+	FDL_CHECK(p_first && p_first == p_second);
+
+	invalidateHandleCache(String(path.c_str()));
+	std::shared_ptr<_CachedHandle> p_third = _acquireHandle(path.c_str());
+	FDL_CHECK(p_third && p_third != p_first);
+
+	//	An invalidated handle stays usable by whoever still holds it
+	char buffer[8];
+	FDL_CHECK(pread(p_first->descriptor, buffer, sizeof(buffer), 0) == 8);
+
+	FDL_CHECK(!_acquireHandle((path + "_missing").c_str()));
+
+	disableHandleCache();
+	FDL_CHECK(!_acquireHandle(path.c_str()));
+	std::remove(path.c_str());
+}
+
+static void _testFileStreams()
+{
+	std::string path = _createFile("streams");
+	FDL_CHECK(enableHandleCache(64));
+
+	//	Streams on a cached handle keep positions of their own
+	File file(String(path.c_str()));
+	FileStream first = file.open();
+	FileStream second = file.open();
+	char buffer[4];
+	FDL_CHECK(first.read(buffer, 4) == 4 && _equals(std::string(buffer, 4).c_str(), "cont"));
+	FDL_CHECK(second.read(buffer, 4) == 4 && _equals(std::string(buffer, 4).c_str(), "cont"));
+	FDL_CHECK(first.read(buffer, 4) == 4 && _equals(std::string(buffer, 4).c_str(), "ents"));
+
+	disableHandleCache();
+	std::remove(path.c_str());
+}
+
+static void _testBudget()
+{
+	FDL_CHECK(enableHandleCache(4));
+
+	//	The budget holds for all shards together, not for each of them
+	std::vector<std::string> paths;
+	for(int i = 0; i < 40; ++i)
+	{
+		paths.push_back(_createFile(("budget" + std::to_string(i)).c_str()));
+		FDL_CHECK(_acquireHandle(paths.back().c_str()));
+		FDL_CHECK(_getCachedHandleCount() <= 4);
+	}
+	FDL_CHECK(_getCachedHandleCount() == 4);
+
+	//	Lowering the budget closes handles right away
+	FDL_CHECK(enableHandleCache(2));
+	FDL_CHECK(_getCachedHandleCount() == 2);
+
+	disableHandleCache();
+	FDL_CHECK(_getCachedHandleCount() == 0);
+	for(std::size_t i = 0; i < paths.size(); ++i) std::remove(paths[i].c_str());
+}
+
+static void _testAccess()
+{
+	std::string path = _createFile("access");
+	chmod(path.c_str(), 0444);
+	FDL_CHECK(enableHandleCache(64));
+
+	//	A read-only file is opened for reading alone once, later hits never
+	//	retry writing
+	std::shared_ptr<_CachedHandle> p_read = _acquireHandle(path.c_str());
+	FDL_CHECK(p_read && p_read->writable == (geteuid() == 0));
+	FDL_CHECK(_acquireHandle(path.c_str()) == p_read);
+
+	//	The mode goes with the handle when it is invalidated
+	chmod(path.c_str(), 0644);
+	invalidateHandleCache(String(path.c_str()));
+	std::shared_ptr<_CachedHandle> p_write = _acquireHandle(path.c_str());
+	FDL_CHECK(p_write && p_write != p_read && p_write->writable);
+	chmod(path.c_str(), 0444);
+	invalidateHandleCache(String(path.c_str()));
+
+	File file(String(path.c_str()));
+	FileStream stream = file.open();
+	char buffer[8];
+	FDL_CHECK(stream.read(buffer, 8) == 8);
+
+	//	Directories are refused even for reading alone
+	std::string directory = path + "_directory";
+	mkdir(directory.c_str(), 0700);
+	FDL_CHECK(!_acquireHandle(directory.c_str()));
+	FDL_CHECK_THROWS(File(String(directory.c_str())).open(), FileStream::IsDirectoryException);
+	FDL_CHECK_THROWS(File(String((path + "_missing").c_str())).open(), File::FileMissingException);
+
+	disableHandleCache();
+	FDL_CHECK_THROWS(File(String(directory.c_str())).open(), FileStream::IsDirectoryException);
+	rmdir(directory.c_str());
+	std::remove(path.c_str());
+}
+
+static void _testFailedWrites()
+{
+	if(access("/dev/full", W_OK) != 0) return;
+	FDL_CHECK(enableHandleCache(64));
+
+	//	A failed write through a cached handle is reported by flush until the
+	//	stream seeks
+	File full(String("/dev/full"));
+	FileStream stream = full.open();
+	stream.write("contents", 8);
+	FDL_CHECK(!stream.flush());
+	FDL_CHECK(stream.tellWrite() == 0);
+	FDL_CHECK(!stream.flush());
+	stream.seekWrite(0);
+	FDL_CHECK(stream.flush());
+
+	disableHandleCache();
+	FileStream uncached = full.open();
+	uncached.write("contents", 8);
+	FDL_CHECK(!uncached.flush());
+}
+
+int main()
+{
+	if(!FDL_IS_POSIX) return 0;
+	_testSharing();
+	_testFileStreams();
+	_testBudget();
+	_testAccess();
+	_testFailedWrites();
+	return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#include "Platform.hpp"
+
+#include "Test.hpp"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace FDL;
+
+//	Containers only move elements on growth when the move can not throw
+static_assert(std::is_nothrow_move_constructible<String>::value, "String moves must not throw");
+static_assert(std::is_nothrow_move_constructible<File>::value, "File moves must not throw");
+static_assert(std::is_nothrow_move_constructible<Directory>::value, "Directory moves must not throw");
+static_assert(std::is_nothrow_move_constructible<FileStream>::value, "FileStream moves must not throw");
+static_assert(!std::is_copy_constructible<FileStream>::value, "FileStream is move-only");
+
+static void _testStrings()
+{
+	//	Moving hands the buffer over and leaves a null string
+	String string("contents");
+	const char* p_buffer = string.c_str();
+	String moved(std::move(string));
+	FDL_CHECK(moved.c_str() == p_buffer);
+	FDL_CHECK(string.isNullStr());
+
+	//	Copies of a borrowed String own their characters
+	char characters[] = "borrowed";
+	String borrowed = String::borrow(characters, 8);
+	String copy(borrowed);
+	FDL_CHECK(borrowed.c_str() == characters);
+	FDL_CHECK(copy.c_str() != characters && _equals(copy.c_str(), "borrowed"));
+}
+
+static void _testFiles()
+{
+	std::string scratch = _makeScratch("Move");
+	_writeFile(scratch + "/file", "contents");
+
+	File file(String((scratch + "/file").c_str()));
+	File moved(std::move(file));
+	FDL_CHECK(_equals(moved.getName().c_str(), "file"));
+
+	//	Growing a vector keeps every path
+	std::vector<File> files;
+	for(int i = 0; i < 100; ++i) files.push_back(File(String(scratch.c_str()), String(("entry" + std::to_string(i)).c_str())));
+	FDL_CHECK(_equals(files[0].getName().c_str(), "entry0") && _equals(files[99].getName().c_str(), "entry99"));
+
+	//	Root and path are joined into a String of the right size
+	File joined(String(scratch.c_str()), String("a/rather/long/relative/path/past/any/small/buffer"));
+	FDL_CHECK(std::string(joined.getFullPath().c_str()) == scratch + "/a/rather/long/relative/path/past/any/small/buffer");
+
+	_removeScratch(scratch);
+}
+
+static void _testFileStreams()
+{
+	std::string scratch = _makeScratch("MoveStream");
+	_writeFile(scratch + "/file", "");
+	File file(String((scratch + "/file").c_str()));
+
+	//	Moving a stream with writes still queued behind it loses none of them
+	FileStream stream = file.open();
+	FDL_CHECK(stream.enableWriteBehind(4, 2));
+	stream.write("contents", 8);
+	FileStream moved(std::move(stream));
+	FDL_CHECK(!moved.isPipelined());
+	FDL_CHECK(moved.tellWrite() == 8);
+	FDL_CHECK(moved.flush());
+	moved.close();
+	FDL_CHECK(_readFile(scratch + "/file") == "contents");
+
+	//	Read-only files still open, for reading
+	chmod((scratch + "/file").c_str(), 0444);
+	FileStream reader = file.open();
+	char buffer[8];
+	FDL_CHECK(reader.read(buffer, 8) == 8);
+
+	_removeScratch(scratch);
+}
+
+static void _testImmutableLists()
+{
+	//	T needs neither a default constructor nor copy assignment
+	String values[] = { String("first"), String("second") };
+	ImmutableList<String> list(values, 2);
+	ImmutableList<String> copy(list);
+	FDL_CHECK(copy.getSize() == 2 && _equals(copy.getValues()[1].c_str(), "second"));
+	FDL_CHECK(copy.getValues()[0].c_str() != list.getValues()[0].c_str());
+
+	ImmutableList<String> moved(std::move(copy));
+	FDL_CHECK(moved.getSize() == 2 && copy.getSize() == 0 && copy.getValues() == NULL);
+	moved = std::move(list);
+	FDL_CHECK(moved.getSize() == 2 && list.getSize() == 0);
+}
+
+int main()
+{
+	if(!FDL_IS_POSIX) return 0;
+	_testStrings();
+	_testFiles();
+	_testFileStreams();
+	_testImmutableLists();
+	return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#include <FDL/FDL.hpp>
+
+#include "Test.hpp"
+
+#include <string>
+
+using namespace FDL;
+
+//	Each static_assert fails the build rather than the run
+static constexpr PathLiteral<sizeof("config\\app.json")> s_windows("config\\app.json");
+static_assert(_equals(s_windows.c_str(), "config/app.json"), "Backslashes become slashes");
+static_assert(s_windows.size() == 15, "Size is the normalized size");
+static_assert(s_windows.getNameOffset() == 7, "Name follows the last slash");
+static_assert(s_windows.getExtensionOffset() == 11, "Extension follows the last dot");
+
+static constexpr PathLiteral<sizeof("a//b/./c.tar.gz")> s_redundant("a//b/./c.tar.gz");
+static_assert(_equals(s_redundant.c_str(), "a/b/c.tar.gz"), "Repeated slashes and . components are removed");
+static_assert(s_redundant.getExtensionOffset() == 10, "Only the last extension counts");
+
+static constexpr PathLiteral<sizeof("./a/.")> s_dots("./a/.");
+static_assert(_equals(s_dots.c_str(), "a"), "Leading and trailing . components are removed");
+
+static constexpr PathLiteral<sizeof(".//a")> s_relative(".//a");
+static_assert(_equals(s_relative.c_str(), "a"), "A relative path stays relative");
+
+static constexpr PathLiteral<sizeof("/./usr//lib")> s_absolute("/./usr//lib");
+static_assert(_equals(s_absolute.c_str(), "/usr/lib"), "An absolute path keeps one leading slash");
+
+static constexpr PathLiteral<sizeof("\\\\server\\share\\file.txt")> s_unc("\\\\server\\share\\file.txt");
+static_assert(_equals(s_unc.c_str(), "//server/share/file.txt"), "A UNC path keeps its leading pair");
+static_assert(s_unc.getNameOffset() == 15, "UNC name offset");
+
+static constexpr PathLiteral<sizeof("C:\\.bashrc")> s_drive("C:\\.bashrc");
+static_assert(_equals(s_drive.c_str(), "C:/.bashrc"), "A drive letter is accepted");
+static_assert(s_drive.getExtensionOffset() == s_drive.size(), "A dot file has no extension");
+
+static constexpr PathLiteral<sizeof("./.")> s_current("./.");
+static_assert(_equals(s_current.c_str(), "."), "The current directory stays");
+
+static constexpr PathLiteral<sizeof("Makefile")> s_plain("Makefile");
+static_assert(s_plain.getNameOffset() == 0, "A bare name starts at 0");
+static_assert(s_plain.getExtensionOffset() == s_plain.size(), "A bare name has no extension");
+
+int main()
+{
+	//	Outside of a constant expression an invalid path throws instead. Only
+	//	Windows forbids characters in names
+#ifdef _WIN32
+	FDL_CHECK_THROWS(PathLiteral<4>("a|b"), BadPathException);
+	FDL_CHECK_THROWS(PathLiteral<5>("ab:c"), BadPathException);
+#else
+	FDL_CHECK(_equals(PathLiteral<9>("a|b:c?*<").c_str(), "a|b:c?*<"));
+#endif
+	FDL_CHECK_THROWS(PathLiteral<3>("a/"), BadPathException);
+	FDL_CHECK_THROWS(PathLiteral<3>("./"), BadPathException);
+	FDL_CHECK_THROWS(PathLiteral<1>(""), BadPathException);
+
+	FDL_CHECK(_equals(FDL_PATH("dir\\file.txt").c_str(), "dir/file.txt"));
+
+	//	File keeps the offsets of a literal and finds them for a runtime path
+	File file(FDL_PATH("dir\\file.txt"));
+	FDL_CHECK(_equals(file.getName().c_str(), "file.txt"));
+	FDL_CHECK(_equals(file.getExtension().c_str(), "txt"));
+
+	File hidden(String("dir/.hidden"));
+	FDL_CHECK(_equals(hidden.getName().c_str(), ".hidden"));
+	FDL_CHECK(_equals(hidden.getExtension().c_str(), ""));
+
+	File joined(String("a.d"), String("b.c.d"));
+	FDL_CHECK(_equals(joined.getName().c_str(), "b.c.d"));
+	FDL_CHECK(_equals(joined.getExtension().c_str(), "d"));
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+	File literal("logs\\out.log"_path);
+	FDL_CHECK(_equals(literal.getName().c_str(), "out.log"));
+#endif
+
+	//	A literal and a runtime path of the same text are the same File
+	const char* texts[] = { "config\\app.json", "a//b/./c", ".//x", "./a/.", "\\\\server\\share", "/./usr//lib", "C:\\x.y" };
+	const PathLiteral<sizeof("config\\app.json")> literal0("config\\app.json");
+	const PathLiteral<sizeof("a//b/./c")> literal1("a//b/./c");
+	const PathLiteral<sizeof(".//x")> literal2(".//x");
+	const PathLiteral<sizeof("./a/.")> literal3("./a/.");
+	const PathLiteral<sizeof("\\\\server\\share")> literal4("\\\\server\\share");
+	const PathLiteral<sizeof("/./usr//lib")> literal5("/./usr//lib");
+	const PathLiteral<sizeof("C:\\x.y")> literal6("C:\\x.y");
+	File fromLiterals[] = { File(literal0), File(literal1), File(literal2), File(literal3), File(literal4),
+		File(literal5), File(literal6) };
+	for(std::size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); ++i)
+	{
+		File fromString(String(texts[i]));
+		FDL_CHECK(_equals(fromLiterals[i].getFullPath().c_str(), fromString.getFullPath().c_str()));
+		FDL_CHECK(_equals(fromLiterals[i].getName().c_str(), fromString.getName().c_str()));
+		FDL_CHECK(_equals(fromLiterals[i].getExtension().c_str(), fromString.getExtension().c_str()));
+		FDL_CHECK(std::string(convertString(String(texts[i])).c_str()) == fromString.getFullPath().c_str());
+	}
+
+	//	And the same rule rejects both
+	FDL_CHECK_THROWS(File(String("a/")), BadPathException);
+	FDL_CHECK_THROWS(File(String("./")), BadPathException);
+	FDL_CHECK_THROWS(File(String("")), BadPathException);
+	FDL_CHECK(convertString(String("a/")).isNullStr());
+
+	return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include "StreamPipeline.hpp"
+
+#include "Test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+using namespace FDL;
+
+static std::string _makeData(std::size_t size)
+{
+	std::string data(size, '\0');
+	for(std::size_t i = 0; i < size; ++i) data[i] = static_cast<char>(i * 31 % 251);
+	return data;
+}
+
+static void _testReadAhead()
+{
+	const std::string data = _makeData(100000);
+	std::size_t offset = 0;
+	_StreamPipeline pipeline(_StreamPipeline::READ_AHEAD, 4096, 4, 10, [&](char* buffer, Int64 size)
+	{
+		std::size_t chunk = std::min(static_cast<std::size_t>(size), data.size() - offset);
+		data.copy(buffer, chunk, offset);
+		offset += chunk;
+		return static_cast<Int64>(chunk);
+	}, NULL);
+
+	//	Odd sizes cross the buffer boundaries
+	std::string result;
+	char buffer[777];
+	Int64 readSize;
+	while((readSize = pipeline.read(buffer, sizeof(buffer))) > 0) result.append(buffer, static_cast<std::size_t>(readSize));
+	FDL_CHECK(result == data);
+	FDL_CHECK(pipeline.getPosition() == 10 + static_cast<Int64>(data.size()));
+	FDL_CHECK(pipeline.read(buffer, sizeof(buffer)) == 0);
+	FDL_CHECK(pipeline.stop());
+}
+
+static void _testReadAheadIsBounded()
+{
+	std::atomic<int> reads(0);
+	_StreamPipeline pipeline(_StreamPipeline::READ_AHEAD, 16, 3, 0, [&](char* buffer, Int64 size)
+	{
+		++reads;
+		for(Int64 i = 0; i < size; ++i) buffer[i] = 'x';
+		return size;
+	}, NULL);
+
+	//	An endless reader only fills the buffers while nobody consumes them
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while(reads < 3 && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	FDL_CHECK(reads == 3);
+
+	char buffer[16];
+	FDL_CHECK(pipeline.read(buffer, sizeof(buffer)) == 16);
+	pipeline.stop();
+	FDL_CHECK(reads <= 4);
+}
+
+static void _testReadFailure()
+{
+	int calls = 0;
+	_StreamPipeline pipeline(_StreamPipeline::READ_AHEAD, 8, 2, 0, [&](char* buffer, Int64 size)
+	{
+		if(calls++ > 0) return static_cast<Int64>(-1);
+		for(Int64 i = 0; i < size; ++i) buffer[i] = 'y';
+		return size;
+	}, NULL);
+
+	//	What was read before the failure is still handed out, then nothing
+	char buffer[32];
+	FDL_CHECK(pipeline.read(buffer, sizeof(buffer)) == 8);
+	FDL_CHECK(pipeline.read(buffer, sizeof(buffer)) == 0);
+}
+
+static void _testWriteBehind()
+{
+	const std::string data = _makeData(50000);
+	std::string result;
+	_StreamPipeline pipeline(_StreamPipeline::WRITE_BEHIND, 1000, 3, 5, NULL, [&](const char* data, Int64 size)
+	{
+		result.append(data, static_cast<std::size_t>(size));
+		return true;
+	});
+
+	for(std::size_t offset = 0; offset < data.size(); offset += 333)
+		FDL_CHECK(pipeline.write(data.data() + offset, static_cast<Int64>(std::min<std::size_t>(333, data.size() - offset))));
+	FDL_CHECK(pipeline.getPosition() == 5 + static_cast<Int64>(data.size()));
+	FDL_CHECK(pipeline.flush());
+	FDL_CHECK(result == data);
+
+	//	stop writes out the partly filled buffer
+	FDL_CHECK(pipeline.write("tail", 4));
+	FDL_CHECK(pipeline.stop());
+	FDL_CHECK(result == data + "tail");
+}
+
+static void _testWriteFailure()
+{
+	_StreamPipeline pipeline(_StreamPipeline::WRITE_BEHIND, 4, 2, 0, NULL, [](const char*, Int64)
+	{
+		return false;
+	});
+
+	pipeline.write("12345678", 8);
+	FDL_CHECK(!pipeline.flush());
+	FDL_CHECK(!pipeline.write("1", 1));
+	FDL_CHECK(!pipeline.stop());
+}
+
+int main()
+{
+	_testReadAhead();
+	_testReadAheadIsBounded();
+	_testReadFailure();
+	_testWriteBehind();
+	_testWriteFailure();
+	return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include "Platform.hpp"
+
+#include "Test.hpp"
+
+#include <csignal>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+using namespace FDL;
+
+static bool _exists(const std::string& path)
+{
+	struct stat status;
+	return lstat(path.c_str(), &status) == 0;
+}
+
+static void _testPublish()
+{
+	std::string scratch = _makeScratch("Publish");
+	Directory directory(String(scratch.c_str()));
+
+	//	The file only appears under its name once published
+	FileStream stream = directory.createTemp();
+	FDL_CHECK(stream.isTemporary());
+	stream.write("contents", 8);
+	FDL_CHECK(stream.flush());
+	FDL_CHECK(!_exists(scratch + "/published"));
+	FDL_CHECK(stream.publish("published"));
+	FDL_CHECK(!stream.isTemporary());
+	FDL_CHECK(_readFile(scratch + "/published") == "contents");
+
+	//	An existing file is never replaced
+	FileStream second = directory.createTemp();
+	second.write("other", 5);
+	FDL_CHECK(!second.publish("published"));
+	FDL_CHECK(second.isTemporary());
+	FDL_CHECK(_readFile(scratch + "/published") == "contents");
+
+	//	Closing unpublished leaves nothing behind
+	second.close();
+	stream.close();
+	FDL_CHECK(directory.getContainedFiles().getSize() == 1);
+
+	_removeScratch(scratch);
+}
+
+static void _testFailedWrite()
+{
+	std::string scratch = _makeScratch("FailedWrite");
+	Directory directory(String(scratch.c_str()));
+
+	//	A file size limit makes the second write fail with EFBIG
+	struct rlimit previous;
+	getrlimit(RLIMIT_FSIZE, &previous);
+	struct rlimit limit = previous;
+	limit.rlim_cur = 8;
+	std::signal(SIGXFSZ, SIG_IGN);
+	FileStream stream = directory.createTemp();
+	FDL_CHECK(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+	stream.write("contents", 8);
+	stream.write("truncated", 9);
+	setrlimit(RLIMIT_FSIZE, &previous);
+
+	FDL_CHECK(!stream.flush());
+	FDL_CHECK(!stream.publish("truncated"));
+	FDL_CHECK(stream.isTemporary());
+	FDL_CHECK(!_exists(scratch + "/truncated"));
+
+	stream.close();
+	_removeScratch(scratch);
+}
+
+static void _testMode()
+{
+	std::string scratch = _makeScratch("Mode");
+	Directory directory(String(scratch.c_str()));
+
+	//	The mode does not depend on whether the file system has O_TMPFILE
+	mode_t previous = umask(027);
+	FileStream stream = directory.createTemp();
+	FDL_CHECK(stream.publish("published"));
+	umask(previous);
+
+	struct stat status;
+	FDL_CHECK(stat((scratch + "/published").c_str(), &status) == 0 && (status.st_mode & 07777) == 0640);
+
+	stream.close();
+	_removeScratch(scratch);
+}
+
+int main()
+{
+	if(!FDL_IS_POSIX) return 0;
+	_testPublish();
+	_testFailedWrite();
+	_testMode();
+	return s_failures == 0 ? 0 : 1;
+}
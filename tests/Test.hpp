@@ -0,0 +1,99 @@
+#ifndef _FDL_TEST_H
+#define _FDL_TEST_H
+
+#include <cstdio>
+
+#ifdef _FDL_POSIX
+#	include <cstdlib>
+#	include <fstream>
+#	include <ftw.h>
+#	include <sstream>
+#	include <string>
+#	include <unistd.h>
+#endif
+
+///////////////////////////////////////
+//	Test Checks
+///////////////////////////////////////
+
+//	Counts the failed checks, a test returns nonzero if any failed
+static int s_failures = 0;
+
+#define FDL_CHECK(condition) \
+do \
+{ \
+	if(!(condition)) \
+	{ \
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+		++s_failures; \
+	} \
+} while(false)
+
+#define FDL_CHECK_THROWS(expression, exception) \
+do \
+{ \
+	bool thrown = false; \
+	try \
+	{ \
+		expression; \
+	} \
+	catch(const exception&) \
+	{ \
+		thrown = true; \
+	} \
+	FDL_CHECK(thrown && #exception); \
+} while(false)
+
+//	Compares two strings, usable while compiling
+static constexpr bool _equals(const char* p_left, const char* p_right)
+{
+	while(*p_left != '\0' && *p_left == *p_right)
+	{
+		++p_left;
+		++p_right;
+	}
+	return *p_left == *p_right;
+}
+
+#ifdef _FDL_POSIX
+
+///////////////////////////////////////
+//	Scratch Files
+///////////////////////////////////////
+
+//	Creates an empty directory of its own under TMPDIR
+inline std::string _makeScratch(const char* name)
+{
+	const char* p_directory = std::getenv("TMPDIR");
+	std::string pattern = std::string(p_directory != NULL ? p_directory : "/tmp") + "/FDLTest" + name + "_XXXXXX";
+	if(mkdtemp(&pattern[0]) == NULL) std::abort();
+	return pattern;
+}
+
+inline int _removeScratchEntry(const char* path, const struct stat*, int, struct FTW*)
+{
+	return std::remove(path);
+}
+
+//	Removes a scratch directory and everything below it
+inline void _removeScratch(const std::string& path)
+{
+	nftw(path.c_str(), _removeScratchEntry, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+inline void _writeFile(const std::string& path, const std::string& contents)
+{
+	std::ofstream(path.c_str(), std::ios_base::binary | std::ios_base::trunc) << contents;
+}
+
+inline std::string _readFile(const std::string& path)
+{
+	std::ifstream stream(path.c_str(), std::ios_base::binary);
+	std::ostringstream contents;
+	contents << stream.rdbuf();
+	return contents.str();
+}
+
+#endif
+
+#endif /* _FDL_TEST_H */